@@ -38,6 +38,44 @@
 
 static bpc_handle_t gs_handle;          /**< bpc handle */
 static int8_t gs_time_zone = 0;          /**< local zone */
+static void (*gs_callback)(bpc_t *data);          /**< receive callback */
+static volatile uint32_t gs_fix_seq;              /**< fix sequence, odd while updating */
+static volatile uint8_t gs_fix_valid;             /**< fix valid flag */
+static int64_t gs_fix_timestamp;                  /**< unix timestamp of the last fix */
+static bpc_time_t gs_fix_ref;                     /**< reference edge time of the last fix */
+static uint8_t gs_fix_confidence;                 /**< confidence of the last fix */
+
+/**
+ * @brief     basic receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      the fix is saved with its reference edge time before the user callback
+ */
+static void a_bpc_basic_receive_callback(bpc_t *data)
+{
+    time_t timestamp;
+    bpc_time_t ref;
+    
+    /* save the fix */
+    if ((data->status == BPC_STATUS_OK) && 
+        (bpc_get_reference_time(&gs_handle, &ref) == 0) &&
+        (bpc_basic_convert_timestamp(data, &timestamp) == 0))
+    {
+        gs_fix_seq++;
+        BPC_MEMORY_BARRIER();
+        gs_fix_timestamp = (int64_t)timestamp;
+        gs_fix_ref = ref;
+        gs_fix_confidence = data->confidence;
+        gs_fix_valid = 1;
+        BPC_MEMORY_BARRIER();
+        gs_fix_seq++;
+    }
+    
+    /* run the user callback */
+    if (gs_callback != NULL)
+    {
+        gs_callback(data);
+    }
+}
 
 /**
  * @brief  basic irq
@@ -56,6 +94,63 @@ uint8_t bpc_basic_irq_handler(void)
     return 0;
 }
 
+/**
+ * @brief     basic irq with an edge timestamp
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t is the time when the edge occurred, e.g. a kernel event time
+ */
+uint8_t bpc_basic_irq_handler_at(const bpc_time_t *t)
+{
+    if (bpc_irq_handler_at(&gs_handle, t) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic irq with an edge timestamp batch
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t must be in time order, e.g. the kernel events read at once
+ */
+uint8_t bpc_basic_irq_handler_batch(const bpc_time_t *t, size_t n)
+{
+    if (bpc_feed_edges(&gs_handle, t, n) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic irq with a pulse and period pair
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the pair is captured by a timer in the pwm input mode
+ */
+uint8_t bpc_basic_irq_handler_pulse(const bpc_time_t *t, uint32_t width_us, uint32_t period_us)
+{
+    if (bpc_feed_pulse(&gs_handle, t, width_us, period_us) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     basic example init
  * @param[in] *callback pointer to an irq callback address
@@ -73,7 +168,11 @@ uint8_t bpc_basic_init(void (*callback)(bpc_t *data))
     DRIVER_BPC_LINK_TIMESTAMP_READ(&gs_handle, bpc_interface_timestamp_read);
     DRIVER_BPC_LINK_DELAY_MS(&gs_handle, bpc_interface_delay_ms);
     DRIVER_BPC_LINK_DEBUG_PRINT(&gs_handle, bpc_interface_debug_print);
-    DRIVER_BPC_LINK_RECEIVE_CALLBACK(&gs_handle, callback);
+    DRIVER_BPC_LINK_RECEIVE_CALLBACK(&gs_handle, a_bpc_basic_receive_callback);
+    
+    /* clear the fix */
+    gs_callback = callback;
+    gs_fix_valid = 0;
     
     /* init */
     res = bpc_init(&gs_handle);
@@ -101,6 +200,9 @@ uint8_t bpc_basic_deinit(void)
         return 1;
     }
     
+    /* clear the fix */
+    gs_fix_valid = 0;
+    
     return 0;
 }
 
@@ -152,9 +254,95 @@ uint8_t bpc_basic_convert_timestamp(bpc_t *t, time_t *timestamp)
     timeptr.tm_hour = t->hour;
     timeptr.tm_min = t->minute;
     timeptr.tm_sec = t->second;
+    timeptr.tm_isdst = 0;
     
     /* make time */
     *timestamp = mktime(&timeptr) - gs_time_zone * 3600;
     
     return 0;
 }
+
+/**
+ * @brief      basic example get the current time
+ * @param[out] *now pointer to a basic time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 no fix
+ *             - 3 fix is busy
+ * @note       the time of the last fix is interpolated by the edge timestamp clock,
+ *             use age_s and confidence to judge the quality
+ */
+uint8_t bpc_basic_now(bpc_basic_time_t *now)
+{
+    uint8_t i;
+    uint8_t valid;
+    uint8_t confidence;
+    uint32_t seq;
+    int64_t timestamp;
+    int64_t diff;
+    bpc_time_t ref;
+    bpc_time_t t;
+    
+    /* read the fix */
+    for (i = 0; i < BPC_BASIC_TIME_READ_RETRY; i++)
+    {
+        seq = gs_fix_seq;
+        BPC_MEMORY_BARRIER();
+        valid = gs_fix_valid;
+        timestamp = gs_fix_timestamp;
+        ref = gs_fix_ref;
+        confidence = gs_fix_confidence;
+        BPC_MEMORY_BARRIER();
+        if (((seq & 1) == 0) && (seq == gs_fix_seq))
+        {
+            break;
+        }
+    }
+    if (i == BPC_BASIC_TIME_READ_RETRY)
+    {
+        return 3;
+    }
+    if (valid == 0)
+    {
+        return 2;
+    }
+    
+    /* read the clock after the fix */
+    if (bpc_interface_timestamp_read(&t) != 0)
+    {
+        return 1;
+    }
+    
+    /* interpolate from the reference edge */
+    diff = (int64_t)((int64_t)t.s - (int64_t)ref.s) * 1000000 + 
+           (int64_t)((int64_t)t.us - (int64_t)ref.us);
+    if (diff < 0)
+    {
+        diff = 0;
+    }
+    now->s = timestamp + diff / 1000000;
+    now->us = (uint32_t)(diff % 1000000);
+    now->age_s = (uint32_t)(diff / 1000000);
+    now->confidence = confidence;
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example read the latest frame
+ * @param[out] *latest pointer to a bpc latest structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it can run in any number of threads or tasks
+ */
+uint8_t bpc_basic_read_latest(bpc_latest_t *latest)
+{
+    if (bpc_read_latest(&gs_handle, latest) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
@@ -51,6 +51,22 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief bpc basic time read retry definition
+ */
+#define BPC_BASIC_TIME_READ_RETRY        8        /**< time read retry times */
+
+/**
+ * @brief bpc basic time structure definition
+ */
+typedef struct bpc_basic_time_s
+{
+    int64_t s;                 /**< unix timestamp */
+    uint32_t us;               /**< microsecond */
+    uint32_t age_s;            /**< seconds since the reference edge of the last fix */
+    uint8_t confidence;        /**< confidence of the last fix in percent */
+} bpc_basic_time_t;
+
 /**
  * @brief  basic irq
  * @return status code
@@ -60,6 +76,39 @@ extern "C"{
  */
 uint8_t bpc_basic_irq_handler(void);
 
+/**
+ * @brief     basic irq with an edge timestamp
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t is the time when the edge occurred, e.g. a kernel event time
+ */
+uint8_t bpc_basic_irq_handler_at(const bpc_time_t *t);
+
+/**
+ * @brief     basic irq with an edge timestamp batch
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t must be in time order, e.g. the kernel events read at once
+ */
+uint8_t bpc_basic_irq_handler_batch(const bpc_time_t *t, size_t n);
+
+/**
+ * @brief     basic irq with a pulse and period pair
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the pair is captured by a timer in the pwm input mode
+ */
+uint8_t bpc_basic_irq_handler_pulse(const bpc_time_t *t, uint32_t width_us, uint32_t period_us);
+
 /**
  * @brief     basic example init
  * @param[in] *callback pointer to an irq callback address
@@ -108,6 +157,29 @@ uint8_t bpc_basic_get_timestamp_time_zone(int8_t *zone);
  */
 uint8_t bpc_basic_convert_timestamp(bpc_t *t, time_t *timestamp);
 
+/**
+ * @brief      basic example get the current time
+ * @param[out] *now pointer to a basic time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 no fix
+ *             - 3 fix is busy
+ * @note       the time of the last fix is interpolated by the edge timestamp clock,
+ *             use age_s and confidence to judge the quality
+ */
+uint8_t bpc_basic_now(bpc_basic_time_t *now);
+
+/**
+ * @brief      basic example read the latest frame
+ * @param[out] *latest pointer to a bpc latest structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it can run in any number of threads or tasks
+ */
+uint8_t bpc_basic_read_latest(bpc_latest_t *latest);
+
 /**
  * @}
  */
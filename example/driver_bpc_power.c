@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ *
+ * @file      driver_bpc_power.c
+ * @brief     driver bpc power source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_power.h"
+
+/**
+ * @brief bpc power frame definition
+ */
+#define BPC_POWER_FRAME_MS 20000        /**< one frame takes 20s */
+
+static bpc_power_config_t gs_config;                   /**< power config */
+static bpc_power_info_t gs_info;                       /**< power info */
+static void (*gs_callback)(bpc_t *data) = NULL;        /**< user callback */
+static volatile uint64_t gs_fix_ms;                    /**< local time of the last fix */
+static volatile uint8_t gs_fix;                        /**< new fix flag */
+static uint64_t gs_last_ms;                            /**< local time of the last run */
+static uint64_t gs_window_ms;                          /**< local time of the next window */
+static uint64_t gs_deadline_ms;                        /**< local time of the window end */
+static uint8_t gs_inited = 0;                          /**< inited flag */
+
+/**
+ * @brief      power example read the local time
+ * @param[out] *ms pointer to a ms buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bpc_power_time(uint64_t *ms)
+{
+    bpc_time_t t;
+    
+    if (bpc_interface_timestamp_read(&t) != 0)
+    {
+        return 1;
+    }
+    *ms = t.s * 1000 + t.us / 1000;
+    
+    return 0;
+}
+
+/**
+ * @brief     power example receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      it runs in the irq context and only saves the time of the fix
+ */
+static void a_bpc_power_callback(bpc_t *data)
+{
+    uint64_t ms;
+    
+    /* save the fix time */
+    if ((data->status == BPC_STATUS_OK) && (a_bpc_power_time(&ms) == 0))
+    {
+        gs_fix_ms = ms;
+        gs_fix = 1;
+    }
+    
+    /* run the user callback */
+    if (gs_callback != NULL)
+    {
+        gs_callback(data);
+    }
+}
+
+/**
+ * @brief     power example init
+ * @param[in] *config pointer to a bpc power config structure
+ * @param[in] *callback pointer to an irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 config is invalid
+ * @note      the receiver is powered on and stays on until the first fix
+ */
+uint8_t bpc_power_init(const bpc_power_config_t *config, void (*callback)(bpc_t *data))
+{
+    /* check the config */
+    if ((config == NULL) || (config->window_frame == 0) || (config->guard_ms >= BPC_POWER_FRAME_MS))
+    {
+        return 4;
+    }
+    
+    /* init the scheduler */
+    memcpy(&gs_config, config, sizeof(bpc_power_config_t));
+    memset(&gs_info, 0, sizeof(bpc_power_info_t));
+    gs_info.state = BPC_POWER_STATE_CONTINUOUS;
+    gs_callback = callback;
+    gs_fix = 0;
+    if (a_bpc_power_time(&gs_last_ms) != 0)
+    {
+        bpc_interface_debug_print("bpc: timestamp read failed.\n");
+        
+        return 1;
+    }
+    
+    /* basic init */
+    if (bpc_basic_init(a_bpc_power_callback) != 0)
+    {
+        return 1;
+    }
+    
+    /* power on */
+    if (bpc_interface_power(1) != 0)
+    {
+        bpc_interface_debug_print("bpc: power on failed.\n");
+        (void)bpc_basic_deinit();
+        
+        return 1;
+    }
+    gs_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  power example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the receiver is powered off
+ */
+uint8_t bpc_power_deinit(void)
+{
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    gs_inited = 0;
+    
+    /* power off */
+    if (bpc_interface_power(0) != 0)
+    {
+        bpc_interface_debug_print("bpc: power off failed.\n");
+        (void)bpc_basic_deinit();
+        
+        return 1;
+    }
+    
+    /* basic deinit */
+    if (bpc_basic_deinit() != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  power example run
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the main loop, it switches the receiver and sleeps until the next window
+ *         or for BPC_POWER_POLL_MS while the receiver is on
+ */
+uint8_t bpc_power_run(void)
+{
+    uint64_t now;
+    uint64_t ms;
+    
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    if (a_bpc_power_time(&now) != 0)
+    {
+        bpc_interface_debug_print("bpc: timestamp read failed.\n");
+        
+        return 1;
+    }
+    
+    /* account the receiver time */
+    if (gs_info.state == BPC_POWER_STATE_SLEEP)
+    {
+        gs_info.off_ms += now - gs_last_ms;
+    }
+    else
+    {
+        gs_info.on_ms += now - gs_last_ms;
+    }
+    gs_last_ms = now;
+    
+    /* a fix predicts the next frames, the frames follow the fix every 20s */
+    if (gs_fix != 0)
+    {
+        gs_fix = 0;
+        if (gs_info.state == BPC_POWER_STATE_WINDOW)
+        {
+            gs_info.window_ok++;
+        }
+        if (gs_config.interval_s != 0)
+        {
+            ms = (uint64_t)gs_config.interval_s * 1000 + gs_config.guard_ms;
+            ms = (ms + BPC_POWER_FRAME_MS - 1) / BPC_POWER_FRAME_MS * BPC_POWER_FRAME_MS;
+            gs_window_ms = gs_fix_ms + ms - gs_config.guard_ms;
+            gs_deadline_ms = gs_window_ms + (uint64_t)gs_config.window_frame * BPC_POWER_FRAME_MS + 
+                             2 * (uint64_t)gs_config.guard_ms;
+            if (bpc_interface_power(0) != 0)
+            {
+                bpc_interface_debug_print("bpc: power off failed.\n");
+                
+                return 1;
+            }
+            gs_info.state = BPC_POWER_STATE_SLEEP;
+        }
+        else
+        {
+            gs_info.state = BPC_POWER_STATE_CONTINUOUS;
+        }
+    }
+    
+    /* switch the receiver */
+    if ((gs_info.state == BPC_POWER_STATE_SLEEP) && (now >= gs_window_ms))
+    {
+        if (bpc_interface_power(1) != 0)
+        {
+            bpc_interface_debug_print("bpc: power on failed.\n");
+            
+            return 1;
+        }
+        gs_info.state = BPC_POWER_STATE_WINDOW;
+    }
+    else if ((gs_info.state == BPC_POWER_STATE_WINDOW) && (now >= gs_deadline_ms))
+    {
+        /* fall back to the continuous reception */
+        gs_info.window_failed++;
+        gs_info.state = BPC_POWER_STATE_CONTINUOUS;
+    }
+    else
+    {
+        /* keep the state */
+    }
+    
+    /* sleep */
+    if (gs_info.state == BPC_POWER_STATE_SLEEP)
+    {
+        ms = gs_window_ms - now;
+        bpc_interface_sleep_ms((ms > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)ms);
+    }
+    else
+    {
+        bpc_interface_sleep_ms(BPC_POWER_POLL_MS);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      power example get the info
+ * @param[out] *info pointer to a bpc power info structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bpc_power_get_info(bpc_power_info_t *info)
+{
+    memcpy(info, &gs_info, sizeof(bpc_power_info_t));
+    
+    return 0;
+}
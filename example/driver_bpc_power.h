@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ *
+ * @file      driver_bpc_power.h
+ * @brief     driver bpc power header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BPC_POWER_H
+#define DRIVER_BPC_POWER_H
+
+#include "driver_bpc_basic.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bpc_example_driver
+ * @{
+ */
+
+/**
+ * @brief bpc power poll definition
+ */
+#ifndef BPC_POWER_POLL_MS
+    #define BPC_POWER_POLL_MS 100        /**< sleep time of one run while the receiver is on */
+#endif
+
+/**
+ * @brief bpc power state enumeration definition
+ */
+typedef enum
+{
+    BPC_POWER_STATE_CONTINUOUS = 0x00,        /**< the receiver is on until a fix */
+    BPC_POWER_STATE_SLEEP      = 0x01,        /**< the receiver is off until the next window */
+    BPC_POWER_STATE_WINDOW     = 0x02,        /**< the receiver is on around the predicted frames */
+} bpc_power_state_t;
+
+/**
+ * @brief bpc power config structure definition
+ */
+typedef struct bpc_power_config_s
+{
+    uint32_t interval_s;        /**< time from a fix to the next resync in s, 0 keeps the receiver on */
+    uint32_t guard_ms;          /**< receiver on time before the predicted frame for the startup and the drift */
+    uint8_t window_frame;       /**< frames tried in a window before the continuous reception */
+} bpc_power_config_t;
+
+/**
+ * @brief bpc power info structure definition
+ */
+typedef struct bpc_power_info_s
+{
+    bpc_power_state_t state;        /**< scheduler state */
+    uint32_t window_ok;             /**< windows with a fix */
+    uint32_t window_failed;         /**< windows without a fix */
+    uint64_t on_ms;                 /**< receiver on time in ms */
+    uint64_t off_ms;                /**< receiver off time in ms */
+} bpc_power_info_t;
+
+/**
+ * @brief     power example init
+ * @param[in] *config pointer to a bpc power config structure
+ * @param[in] *callback pointer to an irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 config is invalid
+ * @note      the receiver is powered on and stays on until the first fix
+ */
+uint8_t bpc_power_init(const bpc_power_config_t *config, void (*callback)(bpc_t *data));
+
+/**
+ * @brief  power example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the receiver is powered off
+ */
+uint8_t bpc_power_deinit(void);
+
+/**
+ * @brief  power example run
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the main loop, it switches the receiver and sleeps until the next window
+ *         or for BPC_POWER_POLL_MS while the receiver is on
+ */
+uint8_t bpc_power_run(void);
+
+/**
+ * @brief      power example get the info
+ * @param[out] *info pointer to a bpc power info structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bpc_power_get_info(bpc_power_info_t *info);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -59,6 +59,29 @@ void bpc_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief     interface sleep ms
+ * @param[in] ms time
+ * @note      the mcu stays in a low power mode, the edge input and the time base must keep running
+ */
+void bpc_interface_sleep_ms(uint32_t ms)
+{
+
+}
+
+/**
+ * @brief     interface receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ *            - 1 power failed
+ * @note      it drives the PON pin of the receiver, the edge input should be masked while the receiver is off
+ */
+uint8_t bpc_interface_power(uint8_t enable)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -35,7 +35,7 @@
  */
 
 #include "driver_bpc_interface.h"
-#include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdarg.h>
 
@@ -45,19 +45,19 @@
  * @return    status code
  *            - 0 success
  *            - 1 read failed
- * @note      none
+ * @note      it uses CLOCK_MONOTONIC, the same clock as the gpio kernel event timestamp
  */
 uint8_t bpc_interface_timestamp_read(bpc_time_t *t)
 {
-    struct timeval time_s;
+    struct timespec time_s;
     
-    if (gettimeofday(&time_s, NULL) < 0)
+    if (clock_gettime(CLOCK_MONOTONIC, &time_s) < 0)
     {
         return 1;
     }
 
     t->s = time_s.tv_sec;
-    t->us = time_s.tv_usec;
+    t->us = time_s.tv_nsec / 1000;
     
     return 0;
 }
@@ -72,6 +72,35 @@ void bpc_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief     interface sleep ms
+ * @param[in] ms time
+ * @note      the gpio thread keeps receiving the edges
+ */
+void bpc_interface_sleep_ms(uint32_t ms)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = (time_t)(ms / 1000);
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    (void)clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
+}
+
+/**
+ * @brief     interface receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ *            - 1 power failed
+ * @note      the PON pin is not connected on this board and the receiver is always on
+ */
+uint8_t bpc_interface_power(uint8_t enable)
+{
+    (void)enable;
+    
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
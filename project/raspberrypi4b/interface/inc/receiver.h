@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      receiver.h
+ * @brief     receiver header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RECEIVER_H
+#define RECEIVER_H
+
+#include "driver_bpc.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup receiver receiver function
+ * @brief    receiver function modules
+ * @{
+ */
+
+/**
+ * @brief receiver max line definition
+ */
+#define RECEIVER_MAX_LINE 8        /**< max gpio lines served at once */
+
+/**
+ * @brief receiver line structure definition
+ */
+typedef struct receiver_line_s
+{
+    const char *chip;             /**< gpio chip path, e.g. /dev/gpiochip0 */
+    uint32_t line;                /**< gpio line offset */
+    bpc_handle_t *handle;         /**< initialized bpc handle decoding this line */
+} receiver_line_t;
+
+/**
+ * @brief     receiver init
+ * @param[in] *line pointer to a receiver line buffer
+ * @param[in] num receiver line buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 param is invalid
+ * @note      one thread waits on all lines with epoll and feeds every edge batch to the handle of its line,
+ *            the receive callbacks run in this thread
+ */
+uint8_t receiver_init(const receiver_line_t *line, uint8_t num);
+
+/**
+ * @brief  receiver deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the thread is woken by an eventfd and joined, it never stops in the middle of a decode
+ */
+uint8_t receiver_deinit(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
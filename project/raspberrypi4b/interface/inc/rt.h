@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.h
+ * @brief     rt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RT_H
+#define RT_H
+
+#include "driver_bpc.h"
+#include <pthread.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup rt rt function
+ * @brief    rt function modules
+ * @{
+ */
+
+/**
+ * @brief rt stack prefault size definition
+ */
+#define RT_STACK_PREFAULT_SIZE (64 * 1024)        /**< touched stack size of a rt pthread */
+
+/**
+ * @brief rt latency max definition
+ */
+#define RT_LATENCY_MAX_US 2000                    /**< latency histogram range in us, 1us per bucket */
+
+/**
+ * @brief rt config structure definition
+ */
+typedef struct rt_config_s
+{
+    uint8_t enable;            /**< 0: default scheduling, 1: rt profile */
+    int32_t priority;          /**< SCHED_FIFO priority */
+    int32_t cpu;               /**< pinned cpu, -1 means no affinity */
+} rt_config_t;
+
+/**
+ * @brief rt latency structure definition
+ */
+typedef struct rt_latency_s
+{
+    uint64_t count;            /**< recorded edge count */
+    uint64_t overflow;         /**< edges over RT_LATENCY_MAX_US */
+    uint32_t min_us;           /**< min latency in us */
+    uint32_t max_us;           /**< max latency in us */
+    uint32_t mean_us;          /**< mean latency in us */
+    uint32_t p50_us;           /**< 50th percentile in us */
+    uint32_t p99_us;           /**< 99th percentile in us */
+    uint32_t p999_us;          /**< 99.9th percentile in us */
+} rt_latency_t;
+
+/**
+ * @brief     rt init
+ * @param[in] *config pointer to a rt config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 config is invalid
+ * @note      call it before the edge pthread is created, the rt profile locks all memory
+ */
+uint8_t rt_init(const rt_config_t *config);
+
+/**
+ * @brief  rt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t rt_deinit(void);
+
+/**
+ * @brief      rt creat a pthread
+ * @param[out] *pid pointer to a pthread id buffer
+ * @param[in]  *routine pointer to a pthread routine
+ * @param[in]  *arg pointer to a routine args buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 creat failed
+ * @note       the rt profile sets SCHED_FIFO and the cpu affinity, otherwise the attributes are default
+ */
+uint8_t rt_pthread_create(pthread_t *pid, void *(*routine)(void *), void *arg);
+
+/**
+ * @brief  rt pthread enter
+ * @note   call it first in the pthread routine, the rt profile prefaults the stack
+ */
+void rt_pthread_enter(void);
+
+/**
+ * @brief     rt enable or disable the latency record
+ * @param[in] enable bool value
+ * @note      enabling clears the histogram
+ */
+void rt_latency_enable(uint8_t enable);
+
+/**
+ * @brief     rt record the latency of edges
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @note      t is the kernel event time in CLOCK_MONOTONIC, call it right before the decoder runs
+ *            and only from one pthread
+ */
+void rt_latency_record(const bpc_time_t *t, size_t n);
+
+/**
+ * @brief      rt get the latency distribution
+ * @param[out] *latency pointer to a rt latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no edge is recorded
+ * @note       percentiles have a 1us resolution
+ */
+uint8_t rt_latency_get(rt_latency_t *latency);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,8 +35,15 @@
  */
 
 #include "gpio.h"
+#include "driver_bpc.h"
+#include "rt.h"
 #include <gpiod.h>
 #include <pthread.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <errno.h>
 
 /**
  * @brief gpio device name definition
@@ -48,65 +55,455 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 
+/**
+ * @brief gpio pthread var definition
+ */
+static pthread_t gs_pid;                 /**< gpio pthread pid */
+static int gs_stop_fd = -1;              /**< stop eventfd */
+
+/**
+ * @brief     gpio wait for an event
+ * @param[in] fd line event fd
+ * @return    status code
+ *            - 0 event is ready
+ *            - 1 stop
+ * @note      it blocks until the line fd or the stop eventfd is readable
+ */
+static uint8_t a_gpio_wait(int fd)
+{
+    int res;
+    struct pollfd fds[2];
+    
+    /* wait for the line and the stop eventfd */
+    fds[0].fd = fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = gs_stop_fd;
+    fds[1].events = POLLIN;
+    while (1)
+    {
+        res = poll(fds, 2, -1);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("gpio: poll failed.\n");
+            
+            return 1;
+        }
+        if (fds[1].revents != 0)
+        {
+            return 1;
+        }
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+            return 0;
+        }
+        if (fds[0].revents != 0)
+        {
+            perror("gpio: line fd failed.\n");
+            
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     gpio start the interrupt pthread
+ * @param[in] *pthread pointer to a pthread function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+static uint8_t a_gpio_pthread_start(void *(*pthread)(void *))
+{
+    /* creat the stop eventfd */
+    gs_stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (gs_stop_fd < 0)
+    {
+        perror("gpio: creat eventfd failed.\n");
+        
+        return 1;
+    }
+    
+    /* creat a gpio interrupt pthread */
+    if (rt_pthread_create(&gs_pid, pthread, NULL) != 0)
+    {
+        perror("gpio: creat pthread failed.\n");
+        (void)close(gs_stop_fd);
+        gs_stop_fd = -1;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio stop the interrupt pthread
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   the pthread is woken by an eventfd and joined, it never stops in the middle of a decode
+ */
+static uint8_t a_gpio_pthread_stop(void)
+{
+    uint64_t stop;
+    
+    /* wake the pthread */
+    stop = 1;
+    if (write(gs_stop_fd, &stop, sizeof(stop)) != (ssize_t)sizeof(stop))
+    {
+        perror("gpio: stop pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* wait for the pthread */
+    if (pthread_join(gs_pid, NULL) != 0)
+    {
+        perror("gpio: join pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* close the stop eventfd */
+    (void)close(gs_stop_fd);
+    gs_stop_fd = -1;
+    
+    return 0;
+}
+
+#ifndef GPIO_GPIOD_V1
+
+/**
+ * @brief gpio event buffer size definition
+ */
+#define GPIO_EVENT_BUFFER_SIZE 16                /**< max events read at once */
+
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;        /**< gpio chip handle */
-static struct gpiod_line *gs_line;        /**< gpio line handle */
-static pthread_t gs_pid;                  /**< gpio pthread pid */
-extern uint8_t (*g_gpio_irq)(void);       /**< gpio irq */
+static struct gpiod_chip *gs_chip;                                     /**< gpio chip handle */
+static struct gpiod_line_request *gs_request;                          /**< gpio line request handle */
+static struct gpiod_edge_event_buffer *gs_buffer;                      /**< gpio edge event buffer */
+extern uint8_t (*g_gpio_irq)(void);                                    /**< gpio irq */
+extern uint8_t (*g_gpio_irq_at)(const bpc_time_t *t);                  /**< gpio irq with the edge timestamp */
+extern uint8_t (*g_gpio_irq_batch)(const bpc_time_t *t, size_t n);     /**< gpio irq with an edge timestamp batch */
+
+/**
+ * @brief     gpio run the irq callback
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @note      the batch callback runs first, then the single edge callbacks
+ */
+static void a_gpio_irq_run(const bpc_time_t *t, size_t n)
+{
+    size_t i;
+    
+    /* check the g_gpio_irq_batch */
+    if (g_gpio_irq_batch != NULL)
+    {
+        /* run the callback once */
+        (void)g_gpio_irq_batch(t, n);
+    }
+    else if (g_gpio_irq_at != NULL)
+    {
+        /* run the callback for every edge */
+        for (i = 0; i < n; i++)
+        {
+            (void)g_gpio_irq_at(&t[i]);
+        }
+    }
+    else if (g_gpio_irq != NULL)
+    {
+        /* run the callback for every edge */
+        for (i = 0; i < n; i++)
+        {
+            (void)g_gpio_irq();
+        }
+    }
+    else
+    {
+        /* do nothing */
+    }
+}
 
 /**
  * @brief  gpio interrupt pthread
  * @param  *p pointer to an args buffer
  * @return NULL
- * @note   none
+ * @note   one read returns all pending events, it returns when the stop eventfd is readable
  */
 static void *a_gpio_interrupt_pthread(void *p)
 {
     int res;
-    struct gpiod_line_event event;
+    int i;
+    uint64_t ns;
+    bpc_time_t t[GPIO_EVENT_BUFFER_SIZE];
+    struct gpiod_edge_event *event;
+    
+    (void)p;
     
-    /* enable catching cancel signal */
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+    /* prefault the stack */
+    rt_pthread_enter();
+    
+    /* loop */
+    while (1)
+    {
+        /* wait for the event or the stop */
+        if (a_gpio_wait(gpiod_line_request_get_fd(gs_request)) != 0)
+        {
+            return NULL;
+        }
+        
+        /* read all pending events */
+        res = gpiod_line_request_read_edge_events(gs_request, gs_buffer, GPIO_EVENT_BUFFER_SIZE);
+        if (res <= 0)
+        {
+            continue;
+        }
+        
+        /* convert the kernel timestamps */
+        for (i = 0; i < res; i++)
+        {
+            event = gpiod_edge_event_buffer_get_event(gs_buffer, (unsigned long)i);
+            ns = gpiod_edge_event_get_timestamp_ns(event);
+            t[i].s = ns / 1000000000ULL;
+            t[i].us = (uint32_t)((ns % 1000000000ULL) / 1000ULL);
+        }
+        
+        /* record the latency */
+        rt_latency_record(t, (size_t)res);
+        
+        /* run the callback */
+        a_gpio_irq_run(t, (size_t)res);
+    }
+}
 
-    /* cancel the pthread at once */
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    unsigned int offset;
+    struct gpiod_line_settings *settings;
+    struct gpiod_line_config *line_config;
+    struct gpiod_request_config *request_config;
+    
+    /* open the gpio group */
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
 
+        return 1;
+    }
+    
+    /* catch the rising and falling edge with the monotonic clock */
+    settings = gpiod_line_settings_new();
+    if (settings == NULL)
+    {
+        perror("gpio: new settings failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    if ((gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT) != 0) ||
+        (gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH) != 0) ||
+        (gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC) != 0))
+    {
+        perror("gpio: set edge events failed.\n");
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* set the gpio line */
+    line_config = gpiod_line_config_new();
+    if (line_config == NULL)
+    {
+        perror("gpio: new line config failed.\n");
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    offset = GPIO_DEVICE_LINE;
+    if (gpiod_line_config_add_line_settings(line_config, &offset, 1, settings) != 0)
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_line_config_free(line_config);
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    gpiod_line_settings_free(settings);
+    
+    /* set the consumer */
+    request_config = gpiod_request_config_new();
+    if (request_config == NULL)
+    {
+        perror("gpio: new request config failed.\n");
+        gpiod_line_config_free(line_config);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    gpiod_request_config_set_consumer(request_config, "gpiointerrupt");
+    
+    /* request the line */
+    gs_request = gpiod_chip_request_lines(gs_chip, request_config, line_config);
+    gpiod_request_config_free(request_config);
+    gpiod_line_config_free(line_config);
+    if (gs_request == NULL)
+    {
+        perror("gpio: request line failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* creat the event buffer */
+    gs_buffer = gpiod_edge_event_buffer_new(GPIO_EVENT_BUFFER_SIZE);
+    if (gs_buffer == NULL)
+    {
+        perror("gpio: new event buffer failed.\n");
+        gpiod_line_request_release(gs_request);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    /* start the gpio interrupt pthread */
+    if (a_gpio_pthread_start(a_gpio_interrupt_pthread) != 0)
+    {
+        gpiod_edge_event_buffer_free(gs_buffer);
+        gpiod_line_request_release(gs_request);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the pthread finishes its batch and is joined before the line is released
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    /* stop the gpio interrupt pthread */
+    if (a_gpio_pthread_stop() != 0)
+    {
+        return 1;
+    }
+
+    /* close the gpio */
+    gpiod_edge_event_buffer_free(gs_buffer);
+    gpiod_line_request_release(gs_request);
+    gpiod_chip_close(gs_chip);
+    
+    return 0;
+}
+
+#else
+
+/**
+ * @brief global var definition
+ */
+static struct gpiod_chip *gs_chip;        /**< gpio chip handle */
+static struct gpiod_line *gs_line;        /**< gpio line handle */
+extern uint8_t (*g_gpio_irq)(void);                          /**< gpio irq */
+extern uint8_t (*g_gpio_irq_at)(const bpc_time_t *t);        /**< gpio irq with the edge timestamp */
+
+/**
+ * @brief     gpio run the irq callback
+ * @param[in] *event pointer to a gpio line event
+ * @note      the kernel event timestamp is CLOCK_MONOTONIC since linux 5.7
+ */
+static void a_gpio_irq_run(const struct gpiod_line_event *event)
+{
+    bpc_time_t t;
+    
+    /* check the g_gpio_irq_at */
+    if (g_gpio_irq_at != NULL)
+    {
+        /* use the kernel timestamp */
+        t.s = (uint64_t)event->ts.tv_sec;
+        t.us = (uint32_t)(event->ts.tv_nsec / 1000);
+        
+        /* record the latency */
+        rt_latency_record(&t, 1);
+        
+        /* run the callback */
+        (void)g_gpio_irq_at(&t);
+    }
+    else if (g_gpio_irq != NULL)
+    {
+        /* run the callback */
+        (void)g_gpio_irq();
+    }
+    else
+    {
+        /* do nothing */
+    }
+}
+
+/**
+ * @brief  gpio interrupt pthread
+ * @param  *p pointer to an args buffer
+ * @return NULL
+ * @note   it returns when the stop eventfd is readable
+ */
+static void *a_gpio_interrupt_pthread(void *p)
+{
+    struct gpiod_line_event event;
+    
+    (void)p;
+    
+    /* prefault the stack */
+    rt_pthread_enter();
+    
     /* loop */
     while (1)
     {
-        /* wait for the event */
-        res = gpiod_line_event_wait(gs_line, NULL);
-        if (res == 1)
+        /* wait for the event or the stop */
+        if (a_gpio_wait(gpiod_line_event_get_fd(gs_line)) != 0)
         {
-            /* read the event */
-            if (gpiod_line_event_read(gs_line, &event) != 0)
-            {
-                continue;
-            }
-            
-            /* if the rising edge */
-            if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
-            {
-                /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
-                {
-                    /* run the callback */
-                    g_gpio_irq();
-                }
-            }
+            return NULL;
+        }
+        
+        /* read the event */
+        if (gpiod_line_event_read(gs_line, &event) != 0)
+        {
+            continue;
+        }
+        
+        /* if the rising edge */
+        if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
+        {
+            /* run the callback */
+            a_gpio_irq_run(&event);
+        }
 
-            /* if the falling edge */
-            if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
-            {
-                /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
-                {
-                    /* run the callback */
-                    g_gpio_irq();
-                }
-            }
+        /* if the falling edge */
+        if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+        {
+            /* run the callback */
+            a_gpio_irq_run(&event);
         }
     }
 }
@@ -120,8 +517,6 @@ static void *a_gpio_interrupt_pthread(void *p)
  */
 uint8_t gpio_interrupt_init(void)
 {
-    uint8_t res;
-    
     /* open the gpio group */
     gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
     if (gs_chip == NULL)
@@ -150,11 +545,9 @@ uint8_t gpio_interrupt_init(void)
         return 1;
     }
 
-    /* creat a gpio interrupt pthread */
-    res = pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL);
-    if (res != 0)
+    /* start the gpio interrupt pthread */
+    if (a_gpio_pthread_start(a_gpio_interrupt_pthread) != 0)
     {
-        perror("gpio: creat pthread failed.\n");
         gpiod_chip_close(gs_chip);
 
         return 1;
@@ -168,18 +561,13 @@ uint8_t gpio_interrupt_init(void)
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   the pthread finishes its event and is joined before the line is released
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    uint8_t res;
-    
-    /* close the gpio interrupt pthread */
-    res = pthread_cancel(gs_pid);
-    if (res != 0)
+    /* stop the gpio interrupt pthread */
+    if (a_gpio_pthread_stop() != 0)
     {
-        perror("gpio: delete pthread failed.\n");
-
         return 1;
     }
 
@@ -188,3 +576,5 @@ uint8_t gpio_interrupt_deinit(void)
     
     return 0;
 }
+
+#endif
@@ -0,0 +1,530 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      receiver.c
+ * @brief     receiver source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "receiver.h"
+#include "rt.h"
+#include <gpiod.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <errno.h>
+
+/**
+ * @brief receiver event buffer size definition
+ */
+#define RECEIVER_EVENT_BUFFER_SIZE 16        /**< max events read at once from one line */
+
+/**
+ * @brief receiver stop index definition
+ */
+#define RECEIVER_STOP_INDEX RECEIVER_MAX_LINE        /**< epoll index of the stop eventfd */
+
+/**
+ * @brief receiver source structure definition
+ */
+typedef struct receiver_source_s
+{
+    struct gpiod_chip *chip;                  /**< gpio chip handle */
+#ifndef GPIO_GPIOD_V1
+    struct gpiod_line_request *request;       /**< gpio line request handle */
+#else
+    struct gpiod_line *line;                  /**< gpio line handle */
+#endif
+    int fd;                                   /**< event fd of the line */
+    bpc_handle_t *handle;                     /**< bpc handle */
+} receiver_source_t;
+
+/**
+ * @brief global var definition
+ */
+static receiver_source_t gs_source[RECEIVER_MAX_LINE];       /**< receiver sources */
+static uint8_t gs_num;                                       /**< receiver source number */
+static int gs_epoll_fd = -1;                                 /**< epoll fd */
+static int gs_stop_fd = -1;                                  /**< stop eventfd */
+static pthread_t gs_pid;                                     /**< receiver pthread pid */
+#ifndef GPIO_GPIOD_V1
+static struct gpiod_edge_event_buffer *gs_buffer;            /**< gpio edge event buffer */
+#endif
+
+#ifndef GPIO_GPIOD_V1
+
+/**
+ * @brief     receiver open a source
+ * @param[in] *source pointer to a receiver source structure
+ * @param[in] *line pointer to a receiver line structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+static uint8_t a_receiver_open(receiver_source_t *source, const receiver_line_t *line)
+{
+    unsigned int offset;
+    struct gpiod_line_settings *settings;
+    struct gpiod_line_config *line_config;
+    struct gpiod_request_config *request_config;
+    
+    /* open the gpio group */
+    source->chip = gpiod_chip_open(line->chip);
+    if (source->chip == NULL)
+    {
+        perror("receiver: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* catch the rising and falling edge with the monotonic clock */
+    settings = gpiod_line_settings_new();
+    line_config = gpiod_line_config_new();
+    request_config = gpiod_request_config_new();
+    offset = line->line;
+    source->request = NULL;
+    if ((settings != NULL) && (line_config != NULL) && (request_config != NULL) &&
+        (gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT) == 0) &&
+        (gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH) == 0) &&
+        (gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC) == 0) &&
+        (gpiod_line_config_add_line_settings(line_config, &offset, 1, settings) == 0))
+    {
+        /* request the line */
+        gpiod_request_config_set_consumer(request_config, "bpcreceiver");
+        source->request = gpiod_chip_request_lines(source->chip, request_config, line_config);
+    }
+    if (request_config != NULL)
+    {
+        gpiod_request_config_free(request_config);
+    }
+    if (line_config != NULL)
+    {
+        gpiod_line_config_free(line_config);
+    }
+    if (settings != NULL)
+    {
+        gpiod_line_settings_free(settings);
+    }
+    if (source->request == NULL)
+    {
+        perror("receiver: request line failed.\n");
+        gpiod_chip_close(source->chip);
+        
+        return 1;
+    }
+    source->fd = gpiod_line_request_get_fd(source->request);
+    
+    return 0;
+}
+
+/**
+ * @brief     receiver close a source
+ * @param[in] *source pointer to a receiver source structure
+ * @note      none
+ */
+static void a_receiver_close(receiver_source_t *source)
+{
+    gpiod_line_request_release(source->request);
+    gpiod_chip_close(source->chip);
+}
+
+/**
+ * @brief      receiver read the pending edges of a source
+ * @param[in]  *source pointer to a receiver source structure
+ * @param[out] *t pointer to an edge timestamp buffer
+ * @return     read edge number
+ * @note       the buffer length is RECEIVER_EVENT_BUFFER_SIZE
+ */
+static size_t a_receiver_read(receiver_source_t *source, bpc_time_t *t)
+{
+    int res;
+    int i;
+    uint64_t ns;
+    struct gpiod_edge_event *event;
+    
+    /* read all pending events */
+    res = gpiod_line_request_read_edge_events(source->request, gs_buffer, RECEIVER_EVENT_BUFFER_SIZE);
+    if (res <= 0)
+    {
+        return 0;
+    }
+    
+    /* convert the kernel timestamps */
+    for (i = 0; i < res; i++)
+    {
+        event = gpiod_edge_event_buffer_get_event(gs_buffer, (unsigned long)i);
+        ns = gpiod_edge_event_get_timestamp_ns(event);
+        t[i].s = ns / 1000000000ULL;
+        t[i].us = (uint32_t)((ns % 1000000000ULL) / 1000ULL);
+    }
+    
+    return (size_t)res;
+}
+
+#else
+
+/**
+ * @brief     receiver open a source
+ * @param[in] *source pointer to a receiver source structure
+ * @param[in] *line pointer to a receiver line structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+static uint8_t a_receiver_open(receiver_source_t *source, const receiver_line_t *line)
+{
+    /* open the gpio group */
+    source->chip = gpiod_chip_open(line->chip);
+    if (source->chip == NULL)
+    {
+        perror("receiver: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the gpio line */
+    source->line = gpiod_chip_get_line(source->chip, line->line);
+    if (source->line == NULL)
+    {
+        perror("receiver: get line failed.\n");
+        gpiod_chip_close(source->chip);
+        
+        return 1;
+    }
+    
+    /* catch the rising and falling edge */
+    if (gpiod_line_request_both_edges_events(source->line, "bpcreceiver") < 0)
+    {
+        perror("receiver: set edge events failed.\n");
+        gpiod_chip_close(source->chip);
+        
+        return 1;
+    }
+    source->fd = gpiod_line_event_get_fd(source->line);
+    
+    return 0;
+}
+
+/**
+ * @brief     receiver close a source
+ * @param[in] *source pointer to a receiver source structure
+ * @note      none
+ */
+static void a_receiver_close(receiver_source_t *source)
+{
+    gpiod_chip_close(source->chip);
+}
+
+/**
+ * @brief      receiver read the pending edges of a source
+ * @param[in]  *source pointer to a receiver source structure
+ * @param[out] *t pointer to an edge timestamp buffer
+ * @return     read edge number
+ * @note       the buffer length is RECEIVER_EVENT_BUFFER_SIZE
+ */
+static size_t a_receiver_read(receiver_source_t *source, bpc_time_t *t)
+{
+    int res;
+    int i;
+    struct gpiod_line_event event[RECEIVER_EVENT_BUFFER_SIZE];
+    
+    /* read all pending events */
+    res = gpiod_line_event_read_multiple(source->line, event, RECEIVER_EVENT_BUFFER_SIZE);
+    if (res <= 0)
+    {
+        return 0;
+    }
+    
+    /* convert the kernel timestamps */
+    for (i = 0; i < res; i++)
+    {
+        t[i].s = (uint64_t)event[i].ts.tv_sec;
+        t[i].us = (uint32_t)(event[i].ts.tv_nsec / 1000);
+    }
+    
+    return (size_t)res;
+}
+
+#endif
+
+/**
+ * @brief     receiver dispatch an edge batch
+ * @param[in] *source pointer to a receiver source structure
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @note      the task mode queues every edge, the irq mode decodes the batch at once
+ */
+static void a_receiver_dispatch(receiver_source_t *source, const bpc_time_t *t, size_t n)
+{
+    size_t i;
+    bpc_mode_t mode;
+    
+    /* get the mode */
+    if (bpc_get_mode(source->handle, &mode) != 0)
+    {
+        return;
+    }
+    
+    if (mode == BPC_MODE_TASK)
+    {
+        /* queue every edge */
+        for (i = 0; i < n; i++)
+        {
+            (void)bpc_irq_handler_at(source->handle, &t[i]);
+        }
+    }
+    else
+    {
+        /* decode the batch */
+        (void)bpc_feed_edges(source->handle, t, n);
+    }
+}
+
+/**
+ * @brief  receiver pthread
+ * @param  *p pointer to an args buffer
+ * @return NULL
+ * @note   it returns when the stop eventfd is readable
+ */
+static void *a_receiver_pthread(void *p)
+{
+    int res;
+    int i;
+    uint32_t index;
+    size_t n;
+    bpc_time_t t[RECEIVER_EVENT_BUFFER_SIZE];
+    struct epoll_event event[RECEIVER_MAX_LINE + 1];
+    
+    (void)p;
+    
+    /* prefault the stack */
+    rt_pthread_enter();
+    
+    /* loop */
+    while (1)
+    {
+        /* wait for all lines */
+        res = epoll_wait(gs_epoll_fd, event, RECEIVER_MAX_LINE + 1, -1);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("receiver: epoll wait failed.\n");
+            
+            return NULL;
+        }
+        
+        /* run all ready lines */
+        for (i = 0; i < res; i++)
+        {
+            index = event[i].data.u32;
+            if (index == RECEIVER_STOP_INDEX)
+            {
+                return NULL;
+            }
+            n = a_receiver_read(&gs_source[index], t);
+            if (n != 0)
+            {
+                rt_latency_record(t, n);
+                a_receiver_dispatch(&gs_source[index], t, n);
+            }
+        }
+    }
+}
+
+/**
+ * @brief  receiver close all fds and sources
+ * @note   none
+ */
+static void a_receiver_release(void)
+{
+    uint8_t i;
+    
+    /* close all sources */
+    for (i = 0; i < gs_num; i++)
+    {
+        a_receiver_close(&gs_source[i]);
+    }
+    gs_num = 0;
+#ifndef GPIO_GPIOD_V1
+    if (gs_buffer != NULL)
+    {
+        gpiod_edge_event_buffer_free(gs_buffer);
+        gs_buffer = NULL;
+    }
+#endif
+    if (gs_stop_fd >= 0)
+    {
+        (void)close(gs_stop_fd);
+        gs_stop_fd = -1;
+    }
+    if (gs_epoll_fd >= 0)
+    {
+        (void)close(gs_epoll_fd);
+        gs_epoll_fd = -1;
+    }
+}
+
+/**
+ * @brief     receiver init
+ * @param[in] *line pointer to a receiver line buffer
+ * @param[in] num receiver line buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 param is invalid
+ * @note      one thread waits on all lines with epoll and feeds every edge batch to the handle of its line,
+ *            the receive callbacks run in this thread
+ */
+uint8_t receiver_init(const receiver_line_t *line, uint8_t num)
+{
+    uint8_t i;
+    struct epoll_event event;
+    
+    /* check the params */
+    if ((line == NULL) || (num == 0) || (num > RECEIVER_MAX_LINE))
+    {
+        return 4;
+    }
+    for (i = 0; i < num; i++)
+    {
+        if ((line[i].chip == NULL) || (line[i].handle == NULL))
+        {
+            return 4;
+        }
+    }
+    
+    /* creat the epoll and the stop eventfd */
+    gs_num = 0;
+    gs_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    gs_stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((gs_epoll_fd < 0) || (gs_stop_fd < 0))
+    {
+        perror("receiver: creat epoll failed.\n");
+        a_receiver_release();
+        
+        return 1;
+    }
+    event.events = EPOLLIN;
+    event.data.u32 = RECEIVER_STOP_INDEX;
+    if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_stop_fd, &event) != 0)
+    {
+        perror("receiver: add eventfd failed.\n");
+        a_receiver_release();
+        
+        return 1;
+    }
+#ifndef GPIO_GPIOD_V1
+    
+    /* creat the event buffer */
+    gs_buffer = gpiod_edge_event_buffer_new(RECEIVER_EVENT_BUFFER_SIZE);
+    if (gs_buffer == NULL)
+    {
+        perror("receiver: new event buffer failed.\n");
+        a_receiver_release();
+        
+        return 1;
+    }
+#endif
+    
+    /* open all lines */
+    for (i = 0; i < num; i++)
+    {
+        if (a_receiver_open(&gs_source[i], &line[i]) != 0)
+        {
+            a_receiver_release();
+            
+            return 1;
+        }
+        gs_source[i].handle = line[i].handle;
+        gs_num++;
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_source[i].fd, &event) != 0)
+        {
+            perror("receiver: add line failed.\n");
+            a_receiver_release();
+            
+            return 1;
+        }
+    }
+    
+    /* creat the receiver pthread */
+    if (rt_pthread_create(&gs_pid, a_receiver_pthread, NULL) != 0)
+    {
+        perror("receiver: creat pthread failed.\n");
+        a_receiver_release();
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  receiver deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the thread is woken by an eventfd and joined, it never stops in the middle of a decode
+ */
+uint8_t receiver_deinit(void)
+{
+    uint64_t stop;
+    
+    /* wake the pthread */
+    stop = 1;
+    if (write(gs_stop_fd, &stop, sizeof(stop)) != (ssize_t)sizeof(stop))
+    {
+        perror("receiver: stop pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* wait for the pthread */
+    if (pthread_join(gs_pid, NULL) != 0)
+    {
+        perror("receiver: join pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* close all */
+    a_receiver_release();
+    
+    return 0;
+}
@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.c
+ * @brief     rt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "rt.h"
+#include <sched.h>
+#include <sys/mman.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static rt_config_t gs_config;                                     /**< rt config */
+static volatile uint8_t gs_latency_enable;                        /**< latency record enable */
+static uint32_t gs_latency_hist[RT_LATENCY_MAX_US + 1];           /**< latency histogram, the last bucket is the overflow */
+static uint64_t gs_latency_count;                                 /**< latency count */
+static uint64_t gs_latency_sum;                                   /**< latency sum in us */
+static uint32_t gs_latency_min;                                   /**< latency min in us */
+static uint32_t gs_latency_max;                                   /**< latency max in us */
+
+/**
+ * @brief     rt init
+ * @param[in] *config pointer to a rt config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 config is invalid
+ * @note      call it before the edge pthread is created, the rt profile locks all memory
+ */
+uint8_t rt_init(const rt_config_t *config)
+{
+    if (config == NULL)
+    {
+        return 4;
+    }
+    
+    /* check the config */
+    if (config->enable != 0)
+    {
+        if ((config->priority < sched_get_priority_min(SCHED_FIFO)) ||
+            (config->priority > sched_get_priority_max(SCHED_FIFO)))
+        {
+            return 4;
+        }
+        if ((config->cpu < -1) || (config->cpu >= CPU_SETSIZE))
+        {
+            return 4;
+        }
+        
+        /* lock the current and the future pages */
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("rt: lock memory failed.\n");
+            
+            return 1;
+        }
+    }
+    gs_config = *config;
+    
+    return 0;
+}
+
+/**
+ * @brief  rt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t rt_deinit(void)
+{
+    if (gs_config.enable != 0)
+    {
+        /* unlock the pages */
+        if (munlockall() != 0)
+        {
+            perror("rt: unlock memory failed.\n");
+            
+            return 1;
+        }
+        gs_config.enable = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      rt creat a pthread
+ * @param[out] *pid pointer to a pthread id buffer
+ * @param[in]  *routine pointer to a pthread routine
+ * @param[in]  *arg pointer to a routine args buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 creat failed
+ * @note       the rt profile sets SCHED_FIFO and the cpu affinity, otherwise the attributes are default
+ */
+uint8_t rt_pthread_create(pthread_t *pid, void *(*routine)(void *), void *arg)
+{
+    int res;
+    pthread_attr_t attr;
+    struct sched_param param;
+    cpu_set_t cpu;
+    
+    /* default attributes */
+    if (gs_config.enable == 0)
+    {
+        return (pthread_create(pid, NULL, routine, arg) == 0) ? 0 : 1;
+    }
+    
+    /* set SCHED_FIFO */
+    if (pthread_attr_init(&attr) != 0)
+    {
+        return 1;
+    }
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = gs_config.priority;
+    res = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    res |= pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    res |= pthread_attr_setschedparam(&attr, &param);
+    
+    /* pin the cpu */
+    if (gs_config.cpu >= 0)
+    {
+        CPU_ZERO(&cpu);
+        CPU_SET(gs_config.cpu, &cpu);
+        res |= pthread_attr_setaffinity_np(&attr, sizeof(cpu), &cpu);
+    }
+    if (res != 0)
+    {
+        perror("rt: set attributes failed.\n");
+        (void)pthread_attr_destroy(&attr);
+        
+        return 1;
+    }
+    
+    /* creat the pthread, it needs CAP_SYS_NICE */
+    res = pthread_create(pid, &attr, routine, arg);
+    (void)pthread_attr_destroy(&attr);
+    if (res != 0)
+    {
+        fprintf(stderr, "rt: creat pthread failed, %s.\n", strerror(res));
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  rt pthread enter
+ * @note   call it first in the pthread routine, the rt profile prefaults the stack
+ */
+void rt_pthread_enter(void)
+{
+    volatile uint8_t stack[RT_STACK_PREFAULT_SIZE];
+    size_t i;
+    
+    if (gs_config.enable == 0)
+    {
+        return;
+    }
+    
+    /* touch every page, mlockall keeps them */
+    for (i = 0; i < RT_STACK_PREFAULT_SIZE; i += 1024)
+    {
+        stack[i] = 0;
+    }
+    (void)stack[0];
+}
+
+/**
+ * @brief     rt enable or disable the latency record
+ * @param[in] enable bool value
+ * @note      enabling clears the histogram
+ */
+void rt_latency_enable(uint8_t enable)
+{
+    if (enable != 0)
+    {
+        gs_latency_enable = 0;
+        memset(gs_latency_hist, 0, sizeof(gs_latency_hist));
+        gs_latency_count = 0;
+        gs_latency_sum = 0;
+        gs_latency_min = UINT32_MAX;
+        gs_latency_max = 0;
+    }
+    gs_latency_enable = enable;
+}
+
+/**
+ * @brief     rt record the latency of edges
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @note      t is the kernel event time in CLOCK_MONOTONIC, call it right before the decoder runs
+ *            and only from one pthread
+ */
+void rt_latency_record(const bpc_time_t *t, size_t n)
+{
+    size_t i;
+    int64_t diff;
+    uint32_t us;
+    struct timespec now;
+    
+    if (gs_latency_enable == 0)
+    {
+        return;
+    }
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return;
+    }
+    
+    for (i = 0; i < n; i++)
+    {
+        /* the edge to the decoder entry */
+        diff = ((int64_t)now.tv_sec - (int64_t)t[i].s) * 1000000 +
+               ((int64_t)(now.tv_nsec / 1000) - (int64_t)t[i].us);
+        us = (diff < 0) ? 0 : ((diff > (int64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)diff);
+        gs_latency_hist[(us < RT_LATENCY_MAX_US) ? us : RT_LATENCY_MAX_US]++;
+        gs_latency_count++;
+        gs_latency_sum += us;
+        if (us < gs_latency_min)
+        {
+            gs_latency_min = us;
+        }
+        if (us > gs_latency_max)
+        {
+            gs_latency_max = us;
+        }
+    }
+}
+
+/**
+ * @brief     rt get a latency percentile
+ * @param[in] permille percentile in 1/1000
+ * @return    percentile in us
+ * @note      none
+ */
+static uint32_t a_rt_latency_percentile(uint32_t permille)
+{
+    uint64_t target;
+    uint64_t sum;
+    uint32_t i;
+    
+    /* the first bucket reaching the rank */
+    target = (gs_latency_count * permille + 999) / 1000;
+    sum = 0;
+    for (i = 0; i < RT_LATENCY_MAX_US; i++)
+    {
+        sum += gs_latency_hist[i];
+        if (sum >= target)
+        {
+            return i;
+        }
+    }
+    
+    return gs_latency_max;
+}
+
+/**
+ * @brief      rt get the latency distribution
+ * @param[out] *latency pointer to a rt latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no edge is recorded
+ * @note       percentiles have a 1us resolution
+ */
+uint8_t rt_latency_get(rt_latency_t *latency)
+{
+    if (gs_latency_count == 0)
+    {
+        return 1;
+    }
+    
+    latency->count = gs_latency_count;
+    latency->overflow = gs_latency_hist[RT_LATENCY_MAX_US];
+    latency->min_us = gs_latency_min;
+    latency->max_us = gs_latency_max;
+    latency->mean_us = (uint32_t)(gs_latency_sum / gs_latency_count);
+    latency->p50_us = a_rt_latency_percentile(500);
+    latency->p99_us = a_rt_latency_percentile(990);
+    latency->p999_us = a_rt_latency_percentile(999);
+    
+    return 0;
+}
@@ -37,14 +37,20 @@
 #include "driver_bpc_basic.h"
 #include "driver_bpc_receive_test.h"
 #include "gpio.h"
+#include "capture.h"
+#include "receiver.h"
+#include "rt.h"
 #include <getopt.h>
 #include <stdlib.h>
 
 /**
  * @brief global var definition
  */
-uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq */
+uint8_t (*g_gpio_irq)(void) = NULL;                                    /**< gpio irq */
+uint8_t (*g_gpio_irq_at)(const bpc_time_t *t) = NULL;                  /**< gpio irq with the edge timestamp */
+uint8_t (*g_gpio_irq_batch)(const bpc_time_t *t, size_t n) = NULL;     /**< gpio irq with an edge timestamp batch */
 volatile uint8_t g_flag;                   /**< interrupt flag */
+static bpc_handle_t gs_receiver_handle[RECEIVER_MAX_LINE];        /**< receiver handles */
 
 /**
  * @brief     interface receive callback
@@ -103,6 +109,25 @@ static void a_receive_callback(bpc_t *data)
     }
 }
 
+/**
+ * @brief     capture irq
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_capture_irq_handler(const bpc_time_t *t)
+{
+    /* write the edge */
+    if (capture_write(t) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     bpc full function
  * @param[in] argc arg numbers
@@ -117,6 +142,7 @@ uint8_t bpc(uint8_t argc, char **argv)
 {
     int c;
     int longindex = 0;
+    uint8_t res;
     char short_options[] = "hipe:t:";
     struct option long_options[] =
     {
@@ -126,10 +152,20 @@ uint8_t bpc(uint8_t argc, char **argv)
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
         {"times", required_argument, NULL, 1},
+        {"output", required_argument, NULL, 2},
+        {"chip", required_argument, NULL, 3},
+        {"line", required_argument, NULL, 4},
+        {"rt-priority", required_argument, NULL, 5},
+        {"rt-cpu", required_argument, NULL, 6},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
+    char *output = NULL;
+    char *chip = "/dev/gpiochip0";
+    uint32_t line[RECEIVER_MAX_LINE];
+    uint8_t line_num = 0;
+    rt_config_t rt = {0, 0, -1};
     
     /* if no params */
     if (argc == 1)
@@ -209,6 +245,59 @@ uint8_t bpc(uint8_t argc, char **argv)
                 break;
             }
 
+            /* capture file */
+            case 2 :
+            {
+                /* set the output */
+                output = optarg;
+
+                break;
+            }
+
+            /* gpio chip */
+            case 3 :
+            {
+                /* set the chip */
+                chip = optarg;
+
+                break;
+            }
+
+            /* gpio line */
+            case 4 :
+            {
+                /* check the line number */
+                if (line_num >= RECEIVER_MAX_LINE)
+                {
+                    return 5;
+                }
+                
+                /* add the line */
+                line[line_num] = atol(optarg);
+                line_num++;
+
+                break;
+            }
+
+            /* rt priority */
+            case 5 :
+            {
+                /* enable the rt profile */
+                rt.enable = 1;
+                rt.priority = atol(optarg);
+
+                break;
+            }
+
+            /* rt cpu */
+            case 6 :
+            {
+                /* set the cpu */
+                rt.cpu = atol(optarg);
+
+                break;
+            }
+
             /* the end */
             case -1 :
             {
@@ -223,6 +312,17 @@ uint8_t bpc(uint8_t argc, char **argv)
         }
     } while (c != -1);
 
+    /* rt init */
+    res = rt_init(&rt);
+    if (res == 4)
+    {
+        return 5;
+    }
+    else if (res != 0)
+    {
+        return 1;
+    }
+
     /* run the function */
     if (strcmp("t_read", type) == 0)
     {
@@ -236,19 +336,80 @@ uint8_t bpc(uint8_t argc, char **argv)
         }
         
         /* set the irq */
-        g_gpio_irq = bpc_receive_test_irq_handler;
+        g_gpio_irq_batch = bpc_receive_test_irq_handler_batch;
         
         /* run the receive test */
         res = bpc_receive_test(times);
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            g_gpio_irq_batch = NULL;
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_batch = NULL;
+        
+        return 0;
+    }
+    else if (strcmp("t_latency", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        rt_latency_t latency;
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* basic init */
+        res = bpc_basic_init(a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            
+            return 1;
+        }
+        
+        /* record the latency */
+        rt_latency_enable(1);
+        g_gpio_irq_batch = bpc_basic_irq_handler_batch;
+        
+        /* record times frames */
+        for (i = 0; i < times; i++)
+        {
+            /* output */
+            bpc_interface_debug_print("%d/%d\n", i + 1, times);
+            
+            /* delay 20s */
+            bpc_interface_delay_ms(20000);
         }
         
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        g_gpio_irq_batch = NULL;
+        rt_latency_enable(0);
+        (void)bpc_basic_deinit();
+        
+        /* output the distribution */
+        res = rt_latency_get(&latency);
+        if (res != 0)
+        {
+            bpc_interface_debug_print("bpc: no edge is received.\n");
+            
+            return 1;
+        }
+        bpc_interface_debug_print("bpc: latency edges is %llu.\n", (unsigned long long)latency.count);
+        bpc_interface_debug_print("bpc: latency min is %uus.\n", latency.min_us);
+        bpc_interface_debug_print("bpc: latency mean is %uus.\n", latency.mean_us);
+        bpc_interface_debug_print("bpc: latency p50 is %uus.\n", latency.p50_us);
+        bpc_interface_debug_print("bpc: latency p99 is %uus.\n", latency.p99_us);
+        bpc_interface_debug_print("bpc: latency p99.9 is %uus.\n", latency.p999_us);
+        bpc_interface_debug_print("bpc: latency max is %uus.\n", latency.max_us);
+        bpc_interface_debug_print("bpc: latency over %dus is %llu.\n", RT_LATENCY_MAX_US, (unsigned long long)latency.overflow);
         
         return 0;
     }
@@ -266,14 +427,14 @@ uint8_t bpc(uint8_t argc, char **argv)
         }
         
         /* set the irq */
-        g_gpio_irq = bpc_basic_irq_handler;
+        g_gpio_irq_batch = bpc_basic_irq_handler_batch;
         
         /* basic init */
         res = bpc_basic_init(a_receive_callback);
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            g_gpio_irq_batch = NULL;
         }
         
         /* set time zone */
@@ -281,7 +442,7 @@ uint8_t bpc(uint8_t argc, char **argv)
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            g_gpio_irq_batch = NULL;
         }
         
         /* loop */
@@ -319,7 +480,7 @@ uint8_t bpc(uint8_t argc, char **argv)
                 bpc_interface_debug_print("bpc: receive timeout.\n");
                 (void)bpc_basic_deinit();
                 (void)gpio_interrupt_deinit();
-                g_gpio_irq = NULL;
+                g_gpio_irq_batch = NULL;
                 
                 return 1;
             }
@@ -330,7 +491,170 @@ uint8_t bpc(uint8_t argc, char **argv)
         
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        g_gpio_irq_batch = NULL;
+        
+        return 0;
+    }
+    else if (strcmp("e_capture", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        
+        /* check the output */
+        if (output == NULL)
+        {
+            return 5;
+        }
+        
+        /* capture open */
+        res = capture_open(output, BPC_CAPTURE_SOURCE_GPIO, 2);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            (void)capture_close();
+            
+            return 1;
+        }
+        
+        /* set the irq */
+        g_gpio_irq_at = a_capture_irq_handler;
+        
+        /* capture times frames */
+        for (i = 0; i < times; i++)
+        {
+            /* output */
+            bpc_interface_debug_print("%d/%d\n", i + 1, times);
+            
+            /* delay 20s */
+            bpc_interface_delay_ms(20000);
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_at = NULL;
+        
+        /* capture close */
+        res = capture_close();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_receiver", type) == 0)
+    {
+        uint8_t res;
+        uint8_t j;
+        uint32_t i;
+        uint16_t timeout;
+        receiver_line_t receiver_line[RECEIVER_MAX_LINE];
+        
+        /* check the line */
+        if (line_num == 0)
+        {
+            return 5;
+        }
+        
+        /* init all handles */
+        for (j = 0; j < line_num; j++)
+        {
+            /* link interface function */
+            DRIVER_BPC_LINK_INIT(&gs_receiver_handle[j], bpc_handle_t);
+            DRIVER_BPC_LINK_TIMESTAMP_READ(&gs_receiver_handle[j], bpc_interface_timestamp_read);
+            DRIVER_BPC_LINK_DELAY_MS(&gs_receiver_handle[j], bpc_interface_delay_ms);
+            DRIVER_BPC_LINK_DEBUG_PRINT(&gs_receiver_handle[j], bpc_interface_debug_print);
+            DRIVER_BPC_LINK_RECEIVE_CALLBACK(&gs_receiver_handle[j], a_receive_callback);
+            
+            /* init */
+            res = bpc_init(&gs_receiver_handle[j]);
+            if (res != 0)
+            {
+                bpc_interface_debug_print("bpc: init failed.\n");
+                while (j != 0)
+                {
+                    j--;
+                    (void)bpc_deinit(&gs_receiver_handle[j]);
+                }
+                
+                return 1;
+            }
+            
+            /* set the line */
+            receiver_line[j].chip = chip;
+            receiver_line[j].line = line[j];
+            receiver_line[j].handle = &gs_receiver_handle[j];
+        }
+        
+        /* receiver init */
+        res = receiver_init(receiver_line, line_num);
+        if (res != 0)
+        {
+            for (j = 0; j < line_num; j++)
+            {
+                (void)bpc_deinit(&gs_receiver_handle[j]);
+            }
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* output */
+            bpc_interface_debug_print("%d/%d\n", i + 1, times);
+            
+            /* 60s timeout */
+            timeout = 6000;
+            
+            /* init 0 */
+            g_flag = 0;
+            
+            /* check timeout */
+            while (timeout != 0)
+            {
+                /* check the flag */
+                if (g_flag != 0)
+                {
+                    break;
+                }
+                
+                /* timeout -- */
+                timeout--;
+                
+                /* delay 10ms */
+                bpc_interface_delay_ms(10);
+            }
+            
+            /* check the timeout */
+            if (timeout == 0)
+            {
+                /* receive timeout */
+                bpc_interface_debug_print("bpc: receive timeout.\n");
+                (void)receiver_deinit();
+                for (j = 0; j < line_num; j++)
+                {
+                    (void)bpc_deinit(&gs_receiver_handle[j]);
+                }
+                
+                return 1;
+            }
+        }
+        
+        /* receiver deinit */
+        (void)receiver_deinit();
+        
+        /* deinit all handles */
+        for (j = 0; j < line_num; j++)
+        {
+            (void)bpc_deinit(&gs_receiver_handle[j]);
+        }
         
         return 0;
     }
@@ -342,15 +666,25 @@ uint8_t bpc(uint8_t argc, char **argv)
         bpc_interface_debug_print("  bpc (-h | --help)\n");
         bpc_interface_debug_print("  bpc (-p | --port)\n");
         bpc_interface_debug_print("  bpc (-t read | --test=read) [--times=<num>]\n");
+        bpc_interface_debug_print("  bpc (-t latency | --test=latency) [--times=<num>]\n");
         bpc_interface_debug_print("  bpc (-e read | --example=read) [--times=<num>]\n");
+        bpc_interface_debug_print("  bpc (-e capture | --example=capture) --output=<path> [--times=<num>]\n");
+        bpc_interface_debug_print("  bpc (-e receiver | --example=receiver) [--chip=<path>] --line=<num> [--line=<num>...] [--times=<num>]\n");
         bpc_interface_debug_print("\n");
         bpc_interface_debug_print("Options:\n");
-        bpc_interface_debug_print("  -e <read>, --example=<read>    Run the driver example.\n");
+        bpc_interface_debug_print("  -e <read | capture | receiver>, --example=<read | capture | receiver>\n");
+        bpc_interface_debug_print("                                 Run the driver example.\n");
+        bpc_interface_debug_print("      --chip=<path>              Set the gpio chip of the receiver example.([default: /dev/gpiochip0])\n");
         bpc_interface_debug_print("  -h, --help                     Show the help.\n");
         bpc_interface_debug_print("  -i, --information              Show the chip information.\n");
+        bpc_interface_debug_print("      --line=<num>               Add a gpio line to the receiver example, up to 8 lines.\n");
+        bpc_interface_debug_print("      --output=<path>            Set the capture file written by the capture example.\n");
         bpc_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
-        bpc_interface_debug_print("  -t <read>, --test=<read>       Run the driver test.\n");
-        bpc_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
+        bpc_interface_debug_print("      --rt-cpu=<num>             Pin the edge thread of the rt profile to a cpu.\n");
+        bpc_interface_debug_print("      --rt-priority=<num>        Enable the rt profile with a SCHED_FIFO priority, 1 - 99.\n");
+        bpc_interface_debug_print("  -t <read | latency>, --test=<read | latency>\n");
+        bpc_interface_debug_print("                                 Run the driver test.\n");
+        bpc_interface_debug_print("      --times=<num>              Set the running times, the capture example captures num frames.([default: 3])\n");
 
         return 0;
     }
@@ -398,6 +732,7 @@ int main(uint8_t argc, char **argv)
     uint8_t res;
     
     res = bpc(argc, argv);
+    (void)rt_deinit();
     if (res == 0)
     {
         /* run success */
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      simulation_driver_bpc_interface.c
+ * @brief     simulation driver bpc interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_interface.h"
+#include "simulation.h"
+#include <stdarg.h>
+
+/**
+ * @brief     interface timestamp read
+ * @param[in] *t pointer to a bpc_time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+uint8_t bpc_interface_timestamp_read(bpc_time_t *t)
+{
+    simulation_clock_read(t);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void bpc_interface_delay_ms(uint32_t ms)
+{
+    simulation_clock_advance(ms);
+}
+
+/**
+ * @brief     interface sleep ms
+ * @param[in] ms time
+ * @note      the virtual clock advances like the delay
+ */
+void bpc_interface_sleep_ms(uint32_t ms)
+{
+    simulation_clock_advance(ms);
+}
+
+/**
+ * @brief     interface receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ *            - 1 power failed
+ * @note      the edges are lost while the simulated receiver is off
+ */
+uint8_t bpc_interface_power(uint8_t enable)
+{
+    simulation_power(enable);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void bpc_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf("%s", str);
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      none
+ */
+void bpc_interface_receive_callback(bpc_t *data)
+{
+    const char week[][10] = 
+    {
+        "Sunday",
+        "Monday",
+        "Tuesday",
+        "Wednesday",
+        "Thursday",
+        "Friday",
+        "Saturday",
+        "Invalid",
+    };
+    
+    switch (data->status)
+    {
+        case BPC_STATUS_OK :
+        {
+            bpc_interface_debug_print("bpc: irq ok.\n");
+            bpc_interface_debug_print("bpc: time is %04d-%02d-%02d %02d:%02d:%02d %s.\n", 
+                                      data->year, data->month, data->day,
+                                      data->hour, data->minute, data->second,
+                                      week[data->week > 7 ? 7 : data->week]);
+            
+            break;
+        }
+        case BPC_STATUS_PARITY_ERR :
+        {
+            bpc_interface_debug_print("bpc: irq parity error.\n");
+            
+            break;
+        }
+        case BPC_STATUS_FRAME_INVALID :
+        {
+            bpc_interface_debug_print("bpc: irq frame invalid.\n");
+            
+            break;
+        }
+        default :
+        {
+            bpc_interface_debug_print("bpc: irq unknown status.\n");
+            
+            break;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      capture.h
+ * @brief     capture header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "driver_bpc_capture.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup capture capture function
+ * @brief    capture function modules
+ * @{
+ */
+
+/**
+ * @brief     capture open a file to write
+ * @param[in] *path pointer to a file path
+ * @param[in] source edge source
+ * @param[in] polarity 0: the pulse is low, 1: the pulse is high, 2: unknown
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the edges are written in us
+ */
+uint8_t capture_open(const char *path, bpc_capture_source_t source, uint8_t polarity);
+
+/**
+ * @brief     capture write an edge
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t capture_write(const bpc_time_t *t);
+
+/**
+ * @brief  capture close the written file
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t capture_close(void);
+
+/**
+ * @brief      capture map a file to read
+ * @param[in]  *path pointer to a file path
+ * @param[out] **buf pointer to a file content address buffer
+ * @param[out] *len pointer to a file length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 map failed
+ * @note       the content is read by bpc_capture_reader_init and bpc_capture_read without a copy
+ */
+uint8_t capture_map(const char *path, const uint8_t **buf, size_t *len);
+
+/**
+ * @brief     capture unmap a file
+ * @param[in] *buf pointer to a file content
+ * @param[in] len file length
+ * @return    status code
+ *            - 0 success
+ *            - 1 unmap failed
+ * @note      none
+ */
+uint8_t capture_unmap(const uint8_t *buf, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
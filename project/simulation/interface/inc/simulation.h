@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      simulation.h
+ * @brief     simulation header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "driver_bpc_encoder.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup simulation simulation function
+ * @brief    simulation function modules
+ * @{
+ */
+
+/**
+ * @brief simulation source enumeration definition
+ */
+typedef enum
+{
+    SIMULATION_SOURCE_SYNTHETIC = 0x00,        /**< edges from the bpc encoder */
+    SIMULATION_SOURCE_RECORDED  = 0x01,        /**< edges from a recorded capture file */
+} simulation_source_t;
+
+/**
+ * @brief simulation config structure definition
+ */
+typedef struct simulation_config_s
+{
+    simulation_source_t source;         /**< edge source */
+    int64_t start;                      /**< unix timestamp of the first frame, a multiple of 20 */
+    bpc_encoder_config_t encoder;       /**< encoder config of the synthetic source */
+    const char *path;                   /**< capture file path of the recorded source */
+} simulation_config_t;
+
+/**
+ * @brief     simulation init
+ * @param[in] *config pointer to a simulation config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the virtual clock starts at config->start for the synthetic source
+ *            and at the first recorded edge for the recorded source
+ */
+uint8_t simulation_init(const simulation_config_t *config);
+
+/**
+ * @brief  simulation deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t simulation_deinit(void);
+
+/**
+ * @brief      simulation read the virtual clock
+ * @param[out] *t pointer to a bpc_time structure
+ * @note       none
+ */
+void simulation_clock_read(bpc_time_t *t);
+
+/**
+ * @brief     simulation advance the virtual clock
+ * @param[in] ms advanced time
+ * @note      every edge inside the advanced time runs g_pwm_irq for the synthetic source, g_gpio_irq_at
+ *            with the edge time or g_gpio_irq with the clock set to the edge time
+ */
+void simulation_clock_advance(uint32_t ms);
+
+/**
+ * @brief     simulation receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @note      the edges are lost while the receiver is off, it is on after the init
+ */
+void simulation_power(uint8_t enable);
+
+/**
+ * @brief      simulation get the frame of the last edge
+ * @param[out] *data pointer to a bpc_t structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame is known
+ * @note       only the synthetic source knows the frame
+ */
+uint8_t simulation_get_frame(bpc_t *data);
+
+/**
+ * @brief      simulation get the edge and frame count
+ * @param[out] *edge pointer to a dispatched edge count buffer
+ * @param[out] *frame pointer to a frame count buffer
+ * @note       none
+ */
+void simulation_get_count(uint64_t *edge, uint32_t *frame);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
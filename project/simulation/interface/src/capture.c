@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      capture.c
+ * @brief     capture source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+#include "capture.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief global var definition
+ */
+static int gs_fd = -1;                           /**< written file */
+static bpc_capture_writer_t gs_writer;           /**< capture writer */
+
+/**
+ * @brief     capture write function
+ * @param[in] offset file offset
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_capture_write(uint64_t offset, const uint8_t *buf, uint32_t len)
+{
+    if (pwrite(gs_fd, buf, len, (off_t)offset) != (ssize_t)len)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     capture open a file to write
+ * @param[in] *path pointer to a file path
+ * @param[in] source edge source
+ * @param[in] polarity 0: the pulse is low, 1: the pulse is high, 2: unknown
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the edges are written in us
+ */
+uint8_t capture_open(const char *path, bpc_capture_source_t source, uint8_t polarity)
+{
+    /* open the file */
+    gs_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (gs_fd < 0)
+    {
+        perror("capture: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* write the header */
+    if (bpc_capture_writer_init(&gs_writer, 1000000, source, polarity, a_capture_write) != 0)
+    {
+        (void)printf("capture: writer init failed.\n");
+        (void)close(gs_fd);
+        gs_fd = -1;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     capture write an edge
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t capture_write(const bpc_time_t *t)
+{
+    if (bpc_capture_write(&gs_writer, t) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  capture close the written file
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t capture_close(void)
+{
+    uint8_t res;
+    
+    if (gs_fd < 0)
+    {
+        return 1;
+    }
+    
+    /* write the last block and the header */
+    res = bpc_capture_writer_close(&gs_writer);
+    if (close(gs_fd) != 0)
+    {
+        res = 1;
+    }
+    gs_fd = -1;
+    if (res != 0)
+    {
+        (void)printf("capture: close failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      capture map a file to read
+ * @param[in]  *path pointer to a file path
+ * @param[out] **buf pointer to a file content address buffer
+ * @param[out] *len pointer to a file length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 map failed
+ * @note       the content is read by bpc_capture_reader_init and bpc_capture_read without a copy
+ */
+uint8_t capture_map(const char *path, const uint8_t **buf, size_t *len)
+{
+    int fd;
+    void *addr;
+    struct stat st;
+    
+    /* open the file */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("capture: open failed.\n");
+        
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size == 0))
+    {
+        (void)printf("capture: file is empty.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* map the file, the mapping is still valid after close */
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        perror("capture: mmap failed.\n");
+        
+        return 1;
+    }
+    
+    /* the edges are read once from the start to the end */
+    (void)madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+    *buf = (const uint8_t *)addr;
+    *len = (size_t)st.st_size;
+    
+    return 0;
+}
+
+/**
+ * @brief     capture unmap a file
+ * @param[in] *buf pointer to a file content
+ * @param[in] len file length
+ * @return    status code
+ *            - 0 success
+ *            - 1 unmap failed
+ * @note      none
+ */
+uint8_t capture_unmap(const uint8_t *buf, size_t len)
+{
+    if (munmap((void *)buf, len) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
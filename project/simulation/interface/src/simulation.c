@@ -0,0 +1,401 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      simulation.c
+ * @brief     simulation source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "simulation.h"
+#include "capture.h"
+#include <time.h>
+
+/**
+ * @brief simulation time definition
+ */
+#define SIMULATION_FRAME_S        20                 /**< one frame takes 20s */
+#define SIMULATION_ZONE_S         (8 * 3600)         /**< bpc broadcasts the beijing time */
+
+/**
+ * @brief global var definition
+ */
+static simulation_config_t gs_config;                          /**< simulation config */
+static bpc_encoder_t gs_encoder;                               /**< synthetic encoder */
+static bpc_time_t gs_edge[BPC_ENCODER_MAX_EDGE];               /**< synthetic edge buffer */
+static uint8_t gs_level[BPC_ENCODER_MAX_EDGE];                 /**< synthetic edge level buffer */
+static uint16_t gs_edge_len;                                   /**< synthetic edge length */
+static uint16_t gs_edge_index;                                 /**< synthetic edge index */
+static int64_t gs_frame_time;                                  /**< start time of the next synthetic frame */
+static bpc_t gs_frame;                                         /**< frame of the buffered edges */
+static uint8_t gs_frame_valid;                                 /**< frame valid flag */
+static bpc_t gs_pulse_frame;                                   /**< frame of the last pulse start */
+static const uint8_t *gs_file;                                 /**< mapped recorded file */
+static size_t gs_file_len;                                     /**< recorded file length */
+static bpc_capture_reader_t gs_reader;                         /**< recorded file reader */
+static uint64_t gs_now_us;                                     /**< virtual clock in us */
+static uint64_t gs_next_us;                                    /**< time of the next edge */
+static uint8_t gs_next_valid;                                  /**< next edge valid flag */
+static uint8_t gs_next_level;                                  /**< level after the next edge */
+static uint64_t gs_pulse_us;                                   /**< time of the last pulse start */
+static uint64_t gs_release_us;                                 /**< time of the last pulse end */
+static uint8_t gs_pulse_valid;                                 /**< pulse start valid flag */
+static uint8_t gs_release_valid;                               /**< pulse end valid flag */
+static uint64_t gs_edge_count;                                 /**< dispatched edge count */
+static uint32_t gs_frame_count;                                /**< encoded frame count */
+static uint8_t gs_power;                                       /**< receiver power flag */
+static uint8_t gs_inited;                                      /**< inited flag */
+extern uint8_t (*g_gpio_irq)(void);                            /**< gpio irq */
+extern uint8_t (*g_gpio_irq_at)(const bpc_time_t *t);          /**< gpio irq with the edge timestamp */
+extern uint8_t (*g_pwm_irq)(const bpc_time_t *t, 
+                            uint32_t width_us, uint32_t period_us);  /**< pwm input irq */
+
+/**
+ * @brief  simulation encode the next synthetic frame
+ * @return status code
+ *         - 0 success
+ *         - 1 encode failed
+ * @note   none
+ */
+static uint8_t a_simulation_encode(void)
+{
+    time_t t;
+    struct tm tm_s;
+    
+    /* the broadcast time of the frame */
+    t = (time_t)(gs_frame_time + SIMULATION_ZONE_S);
+    if (gmtime_r(&t, &tm_s) == NULL)
+    {
+        return 1;
+    }
+    gs_frame.year = (uint16_t)(tm_s.tm_year + 1900);
+    gs_frame.month = (uint8_t)(tm_s.tm_mon + 1);
+    gs_frame.day = (uint8_t)tm_s.tm_mday;
+    gs_frame.week = (uint8_t)tm_s.tm_wday;
+    gs_frame.hour = (uint8_t)tm_s.tm_hour;
+    gs_frame.minute = (uint8_t)tm_s.tm_min;
+    gs_frame.second = (uint8_t)(tm_s.tm_sec + 19);
+    gs_frame.status = BPC_STATUS_OK;
+    
+    /* encode the frame */
+    gs_edge_len = BPC_ENCODER_MAX_EDGE;
+    if (bpc_encode(&gs_encoder, &gs_frame, gs_edge, gs_level, &gs_edge_len) != 0)
+    {
+        return 1;
+    }
+    gs_edge_index = 0;
+    gs_frame_time += SIMULATION_FRAME_S;
+    gs_frame_count++;
+    
+    return 0;
+}
+
+/**
+ * @brief  simulation load the next edge
+ * @return status code
+ *         - 0 success
+ *         - 1 no more edges
+ * @note   none
+ */
+static uint8_t a_simulation_next(void)
+{
+    if (gs_config.source == SIMULATION_SOURCE_SYNTHETIC)
+    {
+        /* a dropped frame may leave no edge */
+        while (gs_edge_index >= gs_edge_len)
+        {
+            if (a_simulation_encode() != 0)
+            {
+                return 1;
+            }
+        }
+        gs_next_us = gs_edge[gs_edge_index].s * 1000000ULL + gs_edge[gs_edge_index].us;
+        gs_next_level = gs_level[gs_edge_index];
+        gs_edge_index++;
+    }
+    else
+    {
+        bpc_time_t t;
+        
+        /* read the mapped capture */
+        if (bpc_capture_read(&gs_reader, &t) != 0)
+        {
+            return 1;
+        }
+        gs_next_us = t.s * 1000000ULL + t.us;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     simulation init
+ * @param[in] *config pointer to a simulation config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the virtual clock starts at config->start for the synthetic source
+ *            and at the first recorded edge for the recorded source
+ */
+uint8_t simulation_init(const simulation_config_t *config)
+{
+    bpc_time_t start;
+    
+    /* copy the config */
+    memcpy(&gs_config, config, sizeof(simulation_config_t));
+    gs_edge_len = 0;
+    gs_edge_index = 0;
+    gs_frame_valid = 0;
+    gs_file = NULL;
+    gs_edge_count = 0;
+    gs_frame_count = 0;
+    gs_pulse_valid = 0;
+    gs_release_valid = 0;
+    gs_power = 1;
+    
+    if (config->source == SIMULATION_SOURCE_SYNTHETIC)
+    {
+        /* the frame starts at 0s, 20s or 40s */
+        if ((config->start < 0) || ((config->start % SIMULATION_FRAME_S) != 0))
+        {
+            (void)printf("simulation: start is invalid.\n");
+            
+            return 1;
+        }
+        
+        /* init the encoder */
+        start.s = (uint64_t)config->start;
+        start.us = 0;
+        if (bpc_encoder_init(&gs_encoder, &config->encoder, &start) != 0)
+        {
+            (void)printf("simulation: encoder init failed.\n");
+            
+            return 1;
+        }
+        gs_frame_time = config->start;
+        gs_now_us = start.s * 1000000ULL;
+    }
+    else
+    {
+        /* map the recorded capture */
+        if (capture_map(config->path, &gs_file, &gs_file_len) != 0)
+        {
+            return 1;
+        }
+        if (bpc_capture_reader_init(&gs_reader, gs_file, gs_file_len) != 0)
+        {
+            (void)printf("simulation: capture is invalid.\n");
+            (void)capture_unmap(gs_file, gs_file_len);
+            gs_file = NULL;
+            
+            return 1;
+        }
+    }
+    
+    /* load the first edge */
+    gs_next_valid = (uint8_t)(a_simulation_next() == 0);
+    if ((config->source == SIMULATION_SOURCE_RECORDED) && (gs_next_valid != 0))
+    {
+        gs_now_us = gs_next_us;
+    }
+    gs_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  simulation deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t simulation_deinit(void)
+{
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    if (gs_file != NULL)
+    {
+        (void)capture_unmap(gs_file, gs_file_len);
+        gs_file = NULL;
+    }
+    gs_inited = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      simulation read the virtual clock
+ * @param[out] *t pointer to a bpc_time structure
+ * @note       none
+ */
+void simulation_clock_read(bpc_time_t *t)
+{
+    t->s = gs_now_us / 1000000ULL;
+    t->us = (uint32_t)(gs_now_us % 1000000ULL);
+}
+
+/**
+ * @brief     simulation pwm input
+ * @note      it works like a timer in the pwm input mode, every pulse start after a complete pulse
+ *            runs g_pwm_irq with the pulse width and the period
+ */
+static void a_simulation_pwm(void)
+{
+    bpc_time_t t;
+    bpc_t frame;
+    
+    /* the pulse end */
+    if (gs_next_level != gs_config.encoder.polarity)
+    {
+        gs_release_us = gs_next_us;
+        gs_release_valid = gs_pulse_valid;
+        
+        return;
+    }
+    
+    /* the pulse start closes the period, the pair belongs to the frame of the closed pulse */
+    if ((gs_pulse_valid != 0) && (gs_release_valid != 0))
+    {
+        t.s = gs_next_us / 1000000ULL;
+        t.us = (uint32_t)(gs_next_us % 1000000ULL);
+        memcpy(&frame, &gs_frame, sizeof(bpc_t));
+        memcpy(&gs_frame, &gs_pulse_frame, sizeof(bpc_t));
+        (void)g_pwm_irq(&t, (uint32_t)(gs_release_us - gs_pulse_us), 
+                        (uint32_t)(gs_next_us - gs_pulse_us));
+        memcpy(&gs_frame, &frame, sizeof(bpc_t));
+    }
+    memcpy(&gs_pulse_frame, &gs_frame, sizeof(bpc_t));
+    gs_pulse_us = gs_next_us;
+    gs_pulse_valid = 1;
+    gs_release_valid = 0;
+}
+
+/**
+ * @brief     simulation advance the virtual clock
+ * @param[in] ms advanced time
+ * @note      every edge inside the advanced time runs g_pwm_irq for the synthetic source, g_gpio_irq_at
+ *            with the edge time or g_gpio_irq with the clock set to the edge time
+ */
+void simulation_clock_advance(uint32_t ms)
+{
+    uint64_t target;
+    
+    target = gs_now_us + (uint64_t)ms * 1000ULL;
+    while ((gs_inited != 0) && (gs_next_valid != 0) && (gs_next_us <= target))
+    {
+        /* an out of order edge never moves the clock back */
+        if (gs_next_us > gs_now_us)
+        {
+            gs_now_us = gs_next_us;
+        }
+        
+        /* the frame owning this edge */
+        gs_frame_valid = (uint8_t)(gs_config.source == SIMULATION_SOURCE_SYNTHETIC);
+        
+        /* run the irq */
+        if (gs_power == 0)
+        {
+            /* the receiver is off */
+        }
+        else if ((g_pwm_irq != NULL) && (gs_config.source == SIMULATION_SOURCE_SYNTHETIC))
+        {
+            a_simulation_pwm();
+        }
+        else if (g_gpio_irq_at != NULL)
+        {
+            bpc_time_t t;
+            
+            t.s = gs_next_us / 1000000ULL;
+            t.us = (uint32_t)(gs_next_us % 1000000ULL);
+            (void)g_gpio_irq_at(&t);
+        }
+        else if (g_gpio_irq != NULL)
+        {
+            (void)g_gpio_irq();
+        }
+        else
+        {
+            /* do nothing */
+        }
+        gs_edge_count += gs_power;
+        
+        /* load the next edge */
+        gs_next_valid = (uint8_t)(a_simulation_next() == 0);
+    }
+    gs_now_us = target;
+}
+
+/**
+ * @brief     simulation receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @note      the edges are lost while the receiver is off, it is on after the init
+ */
+void simulation_power(uint8_t enable)
+{
+    gs_power = (uint8_t)(enable != 0);
+    
+    /* the pwm input restarts with the next complete pulse */
+    gs_pulse_valid = 0;
+    gs_release_valid = 0;
+}
+
+/**
+ * @brief      simulation get the frame of the last edge
+ * @param[out] *data pointer to a bpc_t structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame is known
+ * @note       only the synthetic source knows the frame
+ */
+uint8_t simulation_get_frame(bpc_t *data)
+{
+    if (gs_frame_valid == 0)
+    {
+        return 1;
+    }
+    memcpy(data, &gs_frame, sizeof(bpc_t));
+    
+    return 0;
+}
+
+/**
+ * @brief      simulation get the edge and frame count
+ * @param[out] *edge pointer to a dispatched edge count buffer
+ * @param[out] *frame pointer to a frame count buffer
+ * @note       none
+ */
+void simulation_get_count(uint64_t *edge, uint32_t *frame)
+{
+    *edge = gs_edge_count;
+    *frame = gs_frame_count;
+}
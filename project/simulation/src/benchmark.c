@@ -0,0 +1,519 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      benchmark.c
+ * @brief     benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_encoder.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief benchmark definition
+ */
+#define BENCHMARK_FRAME             64                                                /**< frames of one edge array */
+#define BENCHMARK_MAX_EDGE          (BENCHMARK_FRAME * BPC_ENCODER_MAX_EDGE)          /**< max edges of one edge array */
+#define BENCHMARK_RUN               5                                                 /**< runs of one scenario, the fastest is reported */
+#define BENCHMARK_START             1767225600ULL                                     /**< start time */
+
+/**
+ * @brief benchmark scenario enumeration definition
+ */
+typedef enum
+{
+    BENCHMARK_IDLE = 0,              /**< 1s pulses without a start frame */
+    BENCHMARK_START_FRAME,           /**< a start frame followed by an invalid p1 */
+    BENCHMARK_DECODE,                /**< clean frames */
+    BENCHMARK_DECODE_SOFT,           /**< clean frames with the soft decision */
+    BENCHMARK_DECODE_VOTE,           /**< clean frames with the vote */
+    BENCHMARK_RELOCK,                /**< one frame lost after every two frames */
+    BENCHMARK_SYMBOL_INVALID,        /**< a day pulse out of the windows */
+    BENCHMARK_P1_INVALID,            /**< p1 is 3 */
+    BENCHMARK_PARITY_FIRST,          /**< an hour bit flipped */
+    BENCHMARK_PARITY_SECOND,         /**< a day bit flipped */
+    BENCHMARK_MAX,
+} benchmark_scenario_t;
+
+/**
+ * @brief benchmark result structure definition
+ */
+typedef struct benchmark_result_s
+{
+    uint32_t edge;                   /**< edges of one run */
+    double ns;                       /**< ns per edge */
+    double cycles;                   /**< cycles per edge, 0 if no cycle counter */
+    bpc_stats_t stats;               /**< stats of one run */
+} benchmark_result_t;
+
+/**
+ * @brief global var definition
+ */
+static const char *const gs_name[BENCHMARK_MAX] =
+{
+    "idle",
+    "start",
+    "decode",
+    "decode_soft",
+    "decode_vote",
+    "relock",
+    "symbol_invalid",
+    "p1_invalid",
+    "parity_first",
+    "parity_second",
+};                                                      /**< scenario name */
+static bpc_handle_t gs_handle;                          /**< bpc handle */
+static bpc_time_t gs_edge[BENCHMARK_MAX_EDGE];          /**< edge array */
+static uint32_t gs_edge_len;                            /**< edge array length */
+static uint64_t gs_edge_span;                           /**< edge array time span in s */
+static bpc_time_t gs_now;                               /**< current edge */
+
+/**
+ * @brief     benchmark timestamp read
+ * @param[in] *t pointer to a bpc_time structure
+ * @return    status code
+ *            - 0 success
+ * @note      it returns the current edge of the edge array
+ */
+static uint8_t a_benchmark_timestamp_read(bpc_time_t *t)
+{
+    *t = gs_now;
+    
+    return 0;
+}
+
+/**
+ * @brief     benchmark delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_benchmark_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     benchmark print format data
+ * @param[in] fmt format data
+ * @note      the benchmark keeps the decoder output quiet
+ */
+static void a_benchmark_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     benchmark receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      the stats count the frames
+ */
+static void a_benchmark_receive_callback(bpc_t *data)
+{
+    (void)data;
+}
+
+/**
+ * @brief  benchmark cycle counter
+ * @return cycle count, 0 if no cycle counter
+ * @note   none
+ */
+static inline uint64_t a_benchmark_cycle(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief     benchmark set a pulse width of the last encoded frame
+ * @param[in] base first edge of the frame
+ * @param[in] ind symbol index
+ * @param[in] us pulse width
+ * @note      the frame is clean, so symbol ind is edge 2 * ind and 2 * ind + 1
+ */
+static void a_benchmark_pulse(uint32_t base, uint8_t ind, uint32_t us)
+{
+    bpc_time_t *rise;
+    bpc_time_t *fall;
+    
+    rise = &gs_edge[base + 2 * ind];
+    fall = &gs_edge[base + 2 * ind + 1];
+    fall->s = rise->s + (rise->us + us) / 1000000;
+    fall->us = (rise->us + us) % 1000000;
+}
+
+/**
+ * @brief     benchmark build the edge array of a scenario
+ * @param[in] scenario benchmark scenario
+ * @return    status code
+ *            - 0 success
+ *            - 1 build failed
+ * @note      none
+ */
+static uint8_t a_benchmark_build(benchmark_scenario_t scenario)
+{
+    uint32_t i;
+    uint32_t base;
+    uint16_t len;
+    uint64_t frame_time;
+    time_t t;
+    struct tm tm_s;
+    bpc_t data;
+    bpc_encoder_t encoder;
+    bpc_encoder_config_t config;
+    bpc_time_t start;
+    
+    gs_edge_len = 0;
+    if ((scenario == BENCHMARK_IDLE) || (scenario == BENCHMARK_START_FRAME))
+    {
+        uint32_t period;
+        uint32_t width;
+        
+        /* idle pulses never leave a start frame gap, the start pulses always do */
+        period = (scenario == BENCHMARK_IDLE) ? 1000000 : 2000000;
+        width = (scenario == BENCHMARK_IDLE) ? 100000 : 150000;
+        for (i = 0; i < BENCHMARK_FRAME * BPC_FRAME_SYMBOL_LEN; i++)
+        {
+            gs_edge[gs_edge_len].s = BENCHMARK_START + ((uint64_t)i * period) / 1000000;
+            gs_edge[gs_edge_len].us = (uint32_t)(((uint64_t)i * period) % 1000000);
+            gs_edge[gs_edge_len + 1].s = BENCHMARK_START + ((uint64_t)i * period + width) / 1000000;
+            gs_edge[gs_edge_len + 1].us = (uint32_t)(((uint64_t)i * period + width) % 1000000);
+            gs_edge_len += 2;
+        }
+        gs_edge_span = ((uint64_t)i * period) / 1000000 + 4;
+        
+        return 0;
+    }
+    
+    /* clean encoder */
+    memset(&config, 0, sizeof(bpc_encoder_config_t));
+    config.polarity = 1;
+    config.seed = 1;
+    start.s = BENCHMARK_START;
+    start.us = 0;
+    if (bpc_encoder_init(&encoder, &config, &start) != 0)
+    {
+        return 1;
+    }
+    
+    frame_time = BENCHMARK_START;
+    for (i = 0; i < BENCHMARK_FRAME; i++, frame_time += 20)
+    {
+        /* one frame lost after every two frames */
+        if ((scenario == BENCHMARK_RELOCK) && ((i % 3) == 2))
+        {
+            (void)bpc_encode_skip(&encoder, 1);
+            
+            continue;
+        }
+        
+        /* the broadcast time of the frame */
+        t = (time_t)(frame_time + 8 * 3600);
+        (void)gmtime_r(&t, &tm_s);
+        data.year = (uint16_t)(tm_s.tm_year + 1900);
+        data.month = (uint8_t)(tm_s.tm_mon + 1);
+        data.day = (uint8_t)tm_s.tm_mday;
+        data.week = (uint8_t)tm_s.tm_wday;
+        data.hour = (uint8_t)tm_s.tm_hour;
+        data.minute = (uint8_t)tm_s.tm_min;
+        data.second = (uint8_t)(tm_s.tm_sec + 19);
+        
+        /* encode the frame */
+        base = gs_edge_len;
+        len = BPC_ENCODER_MAX_EDGE;
+        if (bpc_encode(&encoder, &data, &gs_edge[base], NULL, &len) != 0)
+        {
+            return 1;
+        }
+        gs_edge_len += len;
+        
+        /* damage the frame */
+        if (scenario == BENCHMARK_SYMBOL_INVALID)
+        {
+            a_benchmark_pulse(base, 11, 150000);
+        }
+        else if (scenario == BENCHMARK_P1_INVALID)
+        {
+            a_benchmark_pulse(base, 0, 400000);
+        }
+        else if (scenario == BENCHMARK_PARITY_FIRST)
+        {
+            a_benchmark_pulse(base, 3, (uint32_t)(((data.hour % 12) & 0x3) ^ 0x1) * 100000 + 100000);
+        }
+        else if (scenario == BENCHMARK_PARITY_SECOND)
+        {
+            a_benchmark_pulse(base, 12, (uint32_t)((data.day & 0x3) ^ 0x1) * 100000 + 100000);
+        }
+        else
+        {
+            /* keep the frame */
+        }
+    }
+    gs_edge_span = frame_time - BENCHMARK_START + 4;
+    
+    return 0;
+}
+
+/**
+ * @brief      benchmark run a scenario
+ * @param[in]  scenario benchmark scenario
+ * @param[in]  repeat edge array repeat times of one run
+ * @param[out] *result pointer to a benchmark result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_benchmark_run(benchmark_scenario_t scenario, uint32_t repeat, benchmark_result_t *result)
+{
+    uint8_t run;
+    uint32_t r;
+    uint32_t i;
+    uint64_t offset;
+    uint64_t c0;
+    uint64_t c1;
+    double ns;
+    double best_ns;
+    double best_cycles;
+    struct timespec t0;
+    struct timespec t1;
+    
+    if (a_benchmark_build(scenario) != 0)
+    {
+        return 1;
+    }
+    
+    best_ns = 0.0;
+    best_cycles = 0.0;
+    for (run = 0; run < BENCHMARK_RUN; run++)
+    {
+        /* link and init a fresh handle */
+        DRIVER_BPC_LINK_INIT(&gs_handle, bpc_handle_t);
+        DRIVER_BPC_LINK_TIMESTAMP_READ(&gs_handle, a_benchmark_timestamp_read);
+        DRIVER_BPC_LINK_DELAY_MS(&gs_handle, a_benchmark_delay_ms);
+        DRIVER_BPC_LINK_DEBUG_PRINT(&gs_handle, a_benchmark_debug_print);
+        DRIVER_BPC_LINK_RECEIVE_CALLBACK(&gs_handle, a_benchmark_receive_callback);
+        if (bpc_init(&gs_handle) != 0)
+        {
+            return 1;
+        }
+        if (scenario == BENCHMARK_DECODE_SOFT)
+        {
+            (void)bpc_set_soft_decision(&gs_handle, BPC_BOOL_TRUE);
+        }
+        if (scenario == BENCHMARK_DECODE_VOTE)
+        {
+            (void)bpc_set_vote(&gs_handle, BPC_BOOL_TRUE);
+        }
+        
+        /* run the edge array */
+        (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+        c0 = a_benchmark_cycle();
+        for (r = 0, offset = 0; r < repeat; r++, offset += gs_edge_span)
+        {
+            for (i = 0; i < gs_edge_len; i++)
+            {
+                gs_now.s = gs_edge[i].s + offset;
+                gs_now.us = gs_edge[i].us;
+                (void)bpc_irq_handler(&gs_handle);
+            }
+        }
+        c1 = a_benchmark_cycle();
+        (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+        
+        /* keep the fastest run */
+        ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / 
+             ((double)gs_edge_len * repeat);
+        if ((run == 0) || (ns < best_ns))
+        {
+            best_ns = ns;
+            best_cycles = (double)(c1 - c0) / ((double)gs_edge_len * repeat);
+        }
+        (void)bpc_get_stats(&gs_handle, &result->stats);
+        (void)bpc_deinit(&gs_handle);
+    }
+    result->edge = gs_edge_len * repeat;
+    result->ns = best_ns;
+    result->cycles = best_cycles;
+    
+    return 0;
+}
+
+/**
+ * @brief     benchmark main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint8_t json = 0;
+    uint32_t repeat = 64;
+    uint32_t i;
+    benchmark_result_t result;
+    bpc_info_t info;
+    struct option long_options[] =
+    {
+        {"format", required_argument, NULL, 1},
+        {"repeat", required_argument, NULL, 2},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            /* output format */
+            case 1 :
+            {
+                if (strcmp(optarg, "json") == 0)
+                {
+                    json = 1;
+                }
+                else if (strcmp(optarg, "csv") == 0)
+                {
+                    json = 0;
+                }
+                else
+                {
+                    (void)printf("benchmark: format is invalid.\n");
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            
+            /* repeat times */
+            case 2 :
+            {
+                repeat = (uint32_t)strtoul(optarg, NULL, 0);
+                if (repeat == 0)
+                {
+                    (void)printf("benchmark: repeat is invalid.\n");
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            
+            /* help */
+            case 'h' :
+            {
+                (void)printf("Usage:\n");
+                (void)printf("  bpc_benchmark [--format=<csv | json>] [--repeat=<num>]\n");
+                (void)printf("\n");
+                (void)printf("Options:\n");
+                (void)printf("      --format=<csv | json>      Set the report format.([default: csv])\n");
+                (void)printf("  -h, --help                     Show the help.\n");
+                (void)printf("      --repeat=<num>             Set the edge array repeat times of one run.([default: 64])\n");
+                
+                return 0;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    
+    /* output the header */
+    (void)bpc_info(&info);
+    if (json != 0)
+    {
+        (void)printf("{\n  \"driver_version\": %d,\n  \"results\": [\n", (int)info.driver_version);
+    }
+    else
+    {
+        (void)printf("scenario,edges,ns_per_edge,cycles_per_edge,start_frame,frame_ok,symbol_invalid,"
+                     "p1_invalid,parity_first,parity_second,timeout\n");
+    }
+    
+    /* run all scenarios */
+    for (i = 0; i < BENCHMARK_MAX; i++)
+    {
+        if (a_benchmark_run((benchmark_scenario_t)i, repeat, &result) != 0)
+        {
+            (void)printf("benchmark: %s failed.\n", gs_name[i]);
+            
+            return 1;
+        }
+        if (json != 0)
+        {
+            (void)printf("    {\"scenario\": \"%s\", \"edges\": %u, \"ns_per_edge\": %.2f, \"cycles_per_edge\": %.1f, "
+                         "\"start_frame\": %u, \"frame_ok\": %u, \"symbol_invalid\": %u, \"p1_invalid\": %u, "
+                         "\"parity_first\": %u, \"parity_second\": %u, \"timeout\": %u}%s\n",
+                         gs_name[i], result.edge, result.ns, result.cycles,
+                         result.stats.start_frame, result.stats.frame_ok, result.stats.symbol_invalid,
+                         result.stats.p1_invalid, result.stats.parity_first, result.stats.parity_second,
+                         result.stats.timeout, (i + 1 < BENCHMARK_MAX) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%.2f,%.1f,%u,%u,%u,%u,%u,%u,%u\n",
+                         gs_name[i], result.edge, result.ns, result.cycles,
+                         result.stats.start_frame, result.stats.frame_ok, result.stats.symbol_invalid,
+                         result.stats.p1_invalid, result.stats.parity_first, result.stats.parity_second,
+                         result.stats.timeout);
+        }
+    }
+    if (json != 0)
+    {
+        (void)printf("  ]\n}\n");
+    }
+    
+    return 0;
+}
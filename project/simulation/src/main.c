@@ -0,0 +1,1052 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_basic.h"
+#include "driver_bpc_power.h"
+#include "driver_bpc_receive_test.h"
+#include "simulation.h"
+#include "capture.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief reader definition
+ */
+#define READER_MAX           64                 /**< max reader threads */
+#define READER_ZONE_S        (8 * 3600)         /**< bpc broadcasts the beijing time */
+
+/**
+ * @brief outage definition
+ */
+#define OUTAGE_S             5                  /**< signal loss time, longer than the 3s decoder timeout */
+
+/**
+ * @brief reader structure definition
+ */
+typedef struct reader_s
+{
+    pthread_t pid;          /**< reader thread */
+    uint64_t read;          /**< latest reads */
+    uint64_t ok;            /**< latest reads with an ok frame */
+    uint64_t busy;          /**< latest reads failed after the first fix */
+    uint64_t torn;          /**< ok frames not matching their reference edge */
+} reader_t;
+
+/**
+ * @brief global var definition
+ */
+uint8_t (*g_gpio_irq)(void) = NULL;                          /**< gpio irq */
+uint8_t (*g_gpio_irq_at)(const bpc_time_t *t) = NULL;        /**< gpio irq with the edge timestamp */
+uint8_t (*g_pwm_irq)(const bpc_time_t *t, 
+                     uint32_t width_us, uint32_t period_us) = NULL;   /**< pwm input irq */
+volatile uint8_t g_flag;                   /**< interrupt flag */
+static uint32_t gs_match;                  /**< fixes matching the simulated frame */
+static uint32_t gs_mismatch;               /**< fixes not matching the simulated frame */
+static uint32_t gs_failed;                 /**< failed frames */
+static reader_t gs_reader[READER_MAX];     /**< reader threads */
+static volatile uint8_t gs_reader_run;     /**< reader run flag */
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      none
+ */
+static void a_receive_callback(bpc_t *data)
+{
+    const char week[][10] = 
+    {
+        "Sunday",
+        "Monday",
+        "Tuesday",
+        "Wednesday",
+        "Thursday",
+        "Friday",
+        "Saturday",
+        "Invalid",
+    };
+    
+    switch (data->status)
+    {
+        case BPC_STATUS_OK :
+        {
+            time_t timestamp;
+            bpc_t frame;
+            
+            bpc_interface_debug_print("bpc: irq ok.\n");
+            bpc_interface_debug_print("bpc: time is %04d-%02d-%02d %02d:%02d:%02d %s.\n", 
+                                      data->year, data->month, data->day,
+                                      data->hour, data->minute, data->second,
+                                      week[data->week > 7 ? 7 : data->week]);
+            (void)bpc_basic_convert_timestamp(data, &timestamp);
+            bpc_interface_debug_print("bpc: timestamp is %d.\n", timestamp);
+            
+            /* check with the simulated frame */
+            if (simulation_get_frame(&frame) == 0)
+            {
+                if ((frame.year == data->year) && (frame.month == data->month) &&
+                    (frame.day == data->day) && (frame.week == data->week) &&
+                    (frame.hour == data->hour) && (frame.minute == data->minute) &&
+                    (frame.second == data->second))
+                {
+                    gs_match++;
+                }
+                else
+                {
+                    bpc_interface_debug_print("bpc: frame is %04d-%02d-%02d %02d:%02d:%02d.\n", 
+                                              frame.year, frame.month, frame.day,
+                                              frame.hour, frame.minute, frame.second);
+                    gs_mismatch++;
+                }
+            }
+            g_flag = 1;
+            
+            break;
+        }
+        case BPC_STATUS_PARITY_ERR :
+        {
+            bpc_interface_debug_print("bpc: irq parity error.\n");
+            gs_failed++;
+            
+            break;
+        }
+        case BPC_STATUS_FRAME_INVALID :
+        {
+            bpc_interface_debug_print("bpc: irq frame invalid.\n");
+            gs_failed++;
+            
+            break;
+        }
+        default :
+        {
+            bpc_interface_debug_print("bpc: irq unknown status.\n");
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     reader pthread
+ * @param[in] *p pointer to a reader structure
+ * @return    NULL
+ * @note      every ok frame is checked with the time of its reference edge
+ */
+static void *a_reader_pthread(void *p)
+{
+    reader_t *reader = (reader_t *)p;
+    bpc_latest_t latest;
+    struct tm tm;
+    time_t t;
+    
+    while (gs_reader_run != 0)
+    {
+        reader->read++;
+        if (bpc_basic_read_latest(&latest) != 0)
+        {
+            /* no frame before the first fix */
+            if (reader->ok != 0)
+            {
+                reader->busy++;
+            }
+            
+            continue;
+        }
+        if (latest.data.status != BPC_STATUS_OK)
+        {
+            continue;
+        }
+        reader->ok++;
+        
+        /* the reference edge is at the second of the frame */
+        t = (time_t)(latest.ref_time.s + (latest.ref_time.us + 500000) / 1000000 + READER_ZONE_S);
+        (void)gmtime_r(&t, &tm);
+        if ((latest.data.year != tm.tm_year + 1900) || (latest.data.month != tm.tm_mon + 1) ||
+            (latest.data.day != tm.tm_mday) || (latest.data.hour != tm.tm_hour) ||
+            (latest.data.minute != tm.tm_min) || (latest.data.second != tm.tm_sec))
+        {
+            reader->torn++;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     reader start
+ * @param[in] readers reader threads
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+static uint8_t a_reader_start(uint32_t readers)
+{
+    uint32_t i;
+    
+    memset(gs_reader, 0, sizeof(reader_t) * READER_MAX);
+    gs_reader_run = 1;
+    for (i = 0; i < readers; i++)
+    {
+        if (pthread_create(&gs_reader[i].pid, NULL, a_reader_pthread, &gs_reader[i]) != 0)
+        {
+            gs_reader_run = 0;
+            while (i != 0)
+            {
+                i--;
+                (void)pthread_join(gs_reader[i].pid, NULL);
+            }
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reader stop
+ * @param[in] readers reader threads
+ * @note      none
+ */
+static void a_reader_stop(uint32_t readers)
+{
+    uint32_t i;
+    
+    gs_reader_run = 0;
+    for (i = 0; i < readers; i++)
+    {
+        (void)pthread_join(gs_reader[i].pid, NULL);
+    }
+}
+
+/**
+ * @brief     capture irq
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_capture_irq_handler(const bpc_time_t *t)
+{
+    /* write the edge */
+    if (capture_write(t) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bpc full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t bpc(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    char short_options[] = "hipe:t:";
+    struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"information", no_argument, NULL, 'i'},
+        {"port", no_argument, NULL, 'p'},
+        {"example", required_argument, NULL, 'e'},
+        {"test", required_argument, NULL, 't'},
+        {"times", required_argument, NULL, 1},
+        {"file", required_argument, NULL, 2},
+        {"seed", required_argument, NULL, 3},
+        {"jitter", required_argument, NULL, 4},
+        {"drop", required_argument, NULL, 5},
+        {"spurious", required_argument, NULL, 6},
+        {"start", required_argument, NULL, 7},
+        {"output", required_argument, NULL, 8},
+        {"input", required_argument, NULL, 9},
+        {"interval", required_argument, NULL, 10},
+        {"readers", required_argument, NULL, 11},
+        {"outage", required_argument, NULL, 12},
+        {NULL, 0, NULL, 0},
+    };
+    char type[33] = "unknown";
+    uint32_t times = 3;
+    char *output = NULL;
+    uint8_t pwm = 0;
+    uint32_t interval = 3600;
+    uint32_t readers = 0;
+    uint32_t outage = 0;
+    simulation_config_t config;
+    
+    /* default simulation config */
+    memset(&config, 0, sizeof(simulation_config_t));
+    config.source = SIMULATION_SOURCE_SYNTHETIC;
+    config.start = 1767225600;
+    config.encoder.seed = 1;
+    
+    /* if no params */
+    if (argc == 1)
+    {
+        /* goto the help */
+        goto help;
+    }
+
+    /* init 0 */
+    optind = 0;
+
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "h");
+
+                break;
+            }
+
+            /* information */
+            case 'i' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "i");
+
+                break;
+            }
+
+            /* port */
+            case 'p' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "p");
+
+                break;
+            }
+
+            /* example */
+            case 'e' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "e_%s", optarg);
+
+                break;
+            }
+
+            /* test */
+            case 't' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "t_%s", optarg);
+
+                break;
+            }
+
+            /* running times */
+            case 1 :
+            {
+                /* set the times */
+                times = atol(optarg);
+
+                break;
+            }
+
+            /* recorded file */
+            case 2 :
+            {
+                /* set the recorded source */
+                config.source = SIMULATION_SOURCE_RECORDED;
+                config.path = optarg;
+
+                break;
+            }
+
+            /* random seed */
+            case 3 :
+            {
+                /* set the seed */
+                config.encoder.seed = (uint32_t)strtoul(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* edge jitter */
+            case 4 :
+            {
+                /* set the jitter */
+                config.encoder.jitter_us = (uint32_t)strtoul(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* dropped edge */
+            case 5 :
+            {
+                /* set the drop probability */
+                config.encoder.drop_permille = (uint16_t)strtoul(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* spurious pulse */
+            case 6 :
+            {
+                /* set the spurious probability */
+                config.encoder.spurious_permille = (uint16_t)strtoul(optarg, NULL, 0);
+                config.encoder.spurious_max_us = 20000;
+
+                break;
+            }
+
+            /* start time */
+            case 7 :
+            {
+                /* set the start time */
+                config.start = strtoll(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* capture file */
+            case 8 :
+            {
+                /* set the output */
+                output = optarg;
+
+                break;
+            }
+
+            /* edge input */
+            case 9 :
+            {
+                /* set the input */
+                if (strcmp("edge", optarg) == 0)
+                {
+                    pwm = 0;
+                }
+                else if (strcmp("pwm", optarg) == 0)
+                {
+                    pwm = 1;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* resync interval */
+            case 10 :
+            {
+                /* set the interval */
+                interval = (uint32_t)strtoul(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* latest readers */
+            case 11 :
+            {
+                /* set the readers */
+                readers = (uint32_t)strtoul(optarg, NULL, 0);
+                if (readers > READER_MAX)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* signal outage */
+            case 12 :
+            {
+                /* set the outage period */
+                outage = (uint32_t)strtoul(optarg, NULL, 0);
+                if ((outage != 0) && (outage <= OUTAGE_S))
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* run the function */
+    if (strcmp("t_read", type) == 0)
+    {
+        uint8_t res;
+        
+        /* simulation init */
+        res = simulation_init(&config);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* set the irq */
+        g_gpio_irq_at = bpc_receive_test_irq_handler_at;
+        
+        /* run the receive test */
+        res = bpc_receive_test(times);
+        if (res != 0)
+        {
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            
+            return 1;
+        }
+        
+        /* simulation deinit */
+        (void)simulation_deinit();
+        g_gpio_irq_at = NULL;
+        
+        return 0;
+    }
+    else if (strcmp("e_read", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint16_t timeout;
+        uint8_t power;
+        uint32_t frame;
+        uint64_t edge;
+        uint64_t ms;
+        uint64_t read;
+        uint64_t ok;
+        uint64_t busy;
+        uint64_t torn;
+        int64_t error;
+        int64_t max_error;
+        bpc_time_t start;
+        bpc_time_t stop;
+        bpc_time_t clock;
+        bpc_basic_time_t now;
+        struct timespec host_start;
+        struct timespec host_stop;
+        
+        /* simulation init */
+        res = simulation_init(&config);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* set the irq */
+        if (pwm != 0)
+        {
+            g_pwm_irq = bpc_basic_irq_handler_pulse;
+        }
+        else
+        {
+            g_gpio_irq_at = bpc_basic_irq_handler_at;
+        }
+        
+        /* basic init */
+        res = bpc_basic_init(a_receive_callback);
+        if (res != 0)
+        {
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            g_pwm_irq = NULL;
+            
+            return 1;
+        }
+        
+        /* set time zone */
+        res = bpc_basic_set_timestamp_time_zone(8);
+        if (res != 0)
+        {
+            (void)bpc_basic_deinit();
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            g_pwm_irq = NULL;
+            
+            return 1;
+        }
+        
+        /* start the latest readers */
+        res = a_reader_start(readers);
+        if (res != 0)
+        {
+            bpc_interface_debug_print("bpc: start readers failed.\n");
+            (void)bpc_basic_deinit();
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            g_pwm_irq = NULL;
+            
+            return 1;
+        }
+        
+        /* init 0 */
+        gs_match = 0;
+        gs_mismatch = 0;
+        gs_failed = 0;
+        power = 1;
+        max_error = 0;
+        simulation_clock_read(&start);
+        (void)clock_gettime(CLOCK_MONOTONIC, &host_start);
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* output */
+            bpc_interface_debug_print("%d/%d\n", i + 1, times);
+            
+            /* 60s timeout, an outage may lose one more frame */
+            timeout = (outage != 0) ? 8000 : 6000;
+            
+            /* init 0 */
+            g_flag = 0;
+            
+            /* check timeout */
+            while (timeout != 0)
+            {
+                /* check the flag */
+                if (g_flag != 0)
+                {
+                    break;
+                }
+                
+                /* timeout -- */
+                timeout--;
+                
+                /* delay 10ms */
+                bpc_interface_delay_ms(10);
+                
+                /* lose the signal for a while once per outage period */
+                if (outage != 0)
+                {
+                    simulation_clock_read(&clock);
+                    if ((uint8_t)(((clock.s - start.s) % outage) >= OUTAGE_S) != power)
+                    {
+                        power = (uint8_t)(power ^ 1);
+                        simulation_power(power);
+                    }
+                }
+            }
+            
+            /* check the timeout */
+            if (timeout == 0)
+            {
+                /* receive timeout */
+                bpc_interface_debug_print("bpc: receive timeout.\n");
+                a_reader_stop(readers);
+                (void)bpc_basic_deinit();
+                (void)simulation_deinit();
+                g_gpio_irq_at = NULL;
+                g_pwm_irq = NULL;
+                
+                return 1;
+            }
+            
+            /* check the interpolated time with the virtual clock */
+            if (bpc_basic_now(&now) != 0)
+            {
+                bpc_interface_debug_print("bpc: get now failed.\n");
+                a_reader_stop(readers);
+                (void)bpc_basic_deinit();
+                (void)simulation_deinit();
+                g_gpio_irq_at = NULL;
+                g_pwm_irq = NULL;
+                
+                return 1;
+            }
+            simulation_clock_read(&clock);
+            error = (now.s - (int64_t)clock.s) * 1000000 + ((int64_t)now.us - (int64_t)clock.us);
+            if (error < 0)
+            {
+                error = -error;
+            }
+            if (error > max_error)
+            {
+                max_error = error;
+            }
+        }
+        
+        /* stop the latest readers */
+        a_reader_stop(readers);
+        
+        /* output the simulation result */
+        (void)clock_gettime(CLOCK_MONOTONIC, &host_stop);
+        simulation_clock_read(&stop);
+        simulation_get_count(&edge, &frame);
+        ms = (uint64_t)(host_stop.tv_sec - host_start.tv_sec) * 1000 + 
+             (uint64_t)((host_stop.tv_nsec - host_start.tv_nsec) / 1000000);
+        bpc_interface_debug_print("simulation: %u frames, %llu edges, %llu virtual seconds in %llu ms.\n",
+                                  frame, (unsigned long long)edge, 
+                                  (unsigned long long)(stop.s - start.s), (unsigned long long)ms);
+        bpc_interface_debug_print("simulation: %u fixes matched, %u fixes mismatched, %u frames failed.\n", 
+                                  gs_match, gs_mismatch, gs_failed);
+        bpc_interface_debug_print("simulation: max now error is %lld us.\n", (long long)max_error);
+        if (readers != 0)
+        {
+            read = 0;
+            ok = 0;
+            busy = 0;
+            torn = 0;
+            for (i = 0; i < readers; i++)
+            {
+                read += gs_reader[i].read;
+                ok += gs_reader[i].ok;
+                busy += gs_reader[i].busy;
+                torn += gs_reader[i].torn;
+            }
+            bpc_interface_debug_print("simulation: %u readers, %llu reads, %llu ok frames, %llu busy, %llu torn.\n",
+                                      readers, (unsigned long long)read, (unsigned long long)ok,
+                                      (unsigned long long)busy, (unsigned long long)torn);
+            if (torn != 0)
+            {
+                gs_mismatch++;
+            }
+        }
+        
+        /* basic deinit */
+        (void)bpc_basic_deinit();
+        
+        /* simulation deinit */
+        (void)simulation_deinit();
+        g_gpio_irq_at = NULL;
+        g_pwm_irq = NULL;
+        
+        /* check the mismatch */
+        if (gs_mismatch != 0)
+        {
+            return 1;
+        }
+        
+        /* a clean synthetic signal never fails a frame */
+        if ((config.source == SIMULATION_SOURCE_SYNTHETIC) && (config.encoder.jitter_us == 0) &&
+            (config.encoder.drop_permille == 0) && (config.encoder.spurious_permille == 0) && 
+            (gs_failed != 0))
+        {
+            return 1;
+        }
+        
+        /* check the now error */
+        if (max_error >= 1000000)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_power", type) == 0)
+    {
+        uint8_t res;
+        uint32_t frame;
+        uint64_t edge;
+        uint64_t limit;
+        bpc_time_t start;
+        bpc_time_t now;
+        bpc_power_config_t power;
+        bpc_power_info_t info;
+        
+        /* simulation init */
+        res = simulation_init(&config);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* set the irq */
+        g_gpio_irq_at = bpc_basic_irq_handler_at;
+        
+        /* one fix per interval, the receiver starts 5s early and tries 3 frames */
+        power.interval_s = interval;
+        power.guard_ms = 5000;
+        power.window_frame = 3;
+        res = bpc_power_init(&power, a_receive_callback);
+        if (res != 0)
+        {
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            
+            return 1;
+        }
+        
+        /* set time zone */
+        res = bpc_basic_set_timestamp_time_zone(8);
+        if (res != 0)
+        {
+            (void)bpc_power_deinit();
+            (void)simulation_deinit();
+            g_gpio_irq_at = NULL;
+            
+            return 1;
+        }
+        
+        /* init 0 */
+        gs_match = 0;
+        gs_mismatch = 0;
+        simulation_clock_read(&start);
+        limit = (uint64_t)times * (interval + 120) + 120;
+        
+        /* run until times fixes */
+        while (gs_match + gs_mismatch < times)
+        {
+            /* run the scheduler */
+            res = bpc_power_run();
+            simulation_clock_read(&now);
+            if ((res != 0) || (now.s - start.s > limit))
+            {
+                /* receive timeout */
+                bpc_interface_debug_print("bpc: receive timeout.\n");
+                (void)bpc_power_deinit();
+                (void)simulation_deinit();
+                g_gpio_irq_at = NULL;
+                
+                return 1;
+            }
+        }
+        
+        /* output the simulation result */
+        (void)bpc_power_get_info(&info);
+        simulation_get_count(&edge, &frame);
+        bpc_interface_debug_print("simulation: %u frames, %llu edges, %llu virtual seconds.\n",
+                                  frame, (unsigned long long)edge, (unsigned long long)(now.s - start.s));
+        bpc_interface_debug_print("simulation: %u fixes matched, %u fixes mismatched.\n", gs_match, gs_mismatch);
+        bpc_interface_debug_print("power: %u windows ok, %u windows failed, receiver on %llu ms and off %llu ms.\n",
+                                  info.window_ok, info.window_failed, 
+                                  (unsigned long long)info.on_ms, (unsigned long long)info.off_ms);
+        
+        /* power deinit */
+        (void)bpc_power_deinit();
+        
+        /* simulation deinit */
+        (void)simulation_deinit();
+        g_gpio_irq_at = NULL;
+        
+        /* check the mismatch */
+        if (gs_mismatch != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_capture", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t frame;
+        uint64_t edge;
+        
+        /* check the output */
+        if (output == NULL)
+        {
+            return 5;
+        }
+        
+        /* capture open */
+        res = capture_open(output, (config.source == SIMULATION_SOURCE_SYNTHETIC) ? 
+                           BPC_CAPTURE_SOURCE_SYNTHETIC : BPC_CAPTURE_SOURCE_UNKNOWN, 
+                           (config.source == SIMULATION_SOURCE_SYNTHETIC) ? config.encoder.polarity : 2);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* simulation init */
+        res = simulation_init(&config);
+        if (res != 0)
+        {
+            (void)capture_close();
+            
+            return 1;
+        }
+        
+        /* set the irq */
+        g_gpio_irq_at = a_capture_irq_handler;
+        
+        /* capture times frames */
+        for (i = 0; i < times; i++)
+        {
+            bpc_interface_delay_ms(20000);
+        }
+        
+        /* output the capture result */
+        simulation_get_count(&edge, &frame);
+        bpc_interface_debug_print("capture: %llu edges of %u frames.\n", (unsigned long long)edge, times);
+        
+        /* simulation deinit */
+        (void)simulation_deinit();
+        g_gpio_irq_at = NULL;
+        
+        /* capture close */
+        res = capture_close();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("h", type) == 0)
+    {
+        help:
+        bpc_interface_debug_print("Usage:\n");
+        bpc_interface_debug_print("  bpc (-i | --information)\n");
+        bpc_interface_debug_print("  bpc (-h | --help)\n");
+        bpc_interface_debug_print("  bpc (-p | --port)\n");
+        bpc_interface_debug_print("  bpc (-t read | --test=read) [--times=<num>] [--file=<path>] [--seed=<num>]\n");
+        bpc_interface_debug_print("      [--jitter=<us>] [--drop=<permille>] [--spurious=<permille>] [--start=<timestamp>]\n");
+        bpc_interface_debug_print("  bpc (-e read | --example=read) [--times=<num>] [--file=<path>] [--seed=<num>]\n");
+        bpc_interface_debug_print("      [--jitter=<us>] [--drop=<permille>] [--spurious=<permille>] [--start=<timestamp>] [--input=<edge | pwm>]\n");
+        bpc_interface_debug_print("      [--readers=<num>] [--outage=<s>]\n");
+        bpc_interface_debug_print("  bpc (-e capture | --example=capture) --output=<path> [--times=<num>] [--file=<path>] [--seed=<num>]\n");
+        bpc_interface_debug_print("      [--jitter=<us>] [--drop=<permille>] [--spurious=<permille>] [--start=<timestamp>]\n");
+        bpc_interface_debug_print("  bpc (-e power | --example=power) [--times=<num>] [--interval=<s>] [--seed=<num>]\n");
+        bpc_interface_debug_print("      [--jitter=<us>] [--drop=<permille>] [--spurious=<permille>] [--start=<timestamp>]\n");
+        bpc_interface_debug_print("\n");
+        bpc_interface_debug_print("Options:\n");
+        bpc_interface_debug_print("      --drop=<permille>          Set the dropped edge probability.([default: 0])\n");
+        bpc_interface_debug_print("  -e <read | capture | power>, --example=<read | capture | power>\n");
+        bpc_interface_debug_print("                                 Run the driver example.\n");
+        bpc_interface_debug_print("      --file=<path>              Replay the edges of a capture file.\n");
+        bpc_interface_debug_print("  -h, --help                     Show the help.\n");
+        bpc_interface_debug_print("  -i, --information              Show the chip information.\n");
+        bpc_interface_debug_print("      --input=<edge | pwm>       Set the read example input, every edge or one pulse and period pair per second.([default: edge])\n");
+        bpc_interface_debug_print("      --interval=<s>             Set the resync interval of the power example.([default: 3600])\n");
+        bpc_interface_debug_print("      --jitter=<us>              Set the max edge jitter.([default: 0])\n");
+        bpc_interface_debug_print("      --outage=<s>               Lose the signal for 5s once per s seconds in the read example.([default: 0])\n");
+        bpc_interface_debug_print("      --output=<path>            Set the capture file written by the capture example.\n");
+        bpc_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
+        bpc_interface_debug_print("      --readers=<num>            Set the threads reading the latest frame in the read example.([default: 0])\n");
+        bpc_interface_debug_print("      --seed=<num>               Set the random seed.([default: 1])\n");
+        bpc_interface_debug_print("      --spurious=<permille>      Set the spurious pulse probability.([default: 0])\n");
+        bpc_interface_debug_print("      --start=<timestamp>        Set the unix timestamp of the first frame.([default: 1767225600])\n");
+        bpc_interface_debug_print("  -t <read>, --test=<read>       Run the driver test.\n");
+        bpc_interface_debug_print("      --times=<num>              Set the running times, the capture example captures num frames\n");
+        bpc_interface_debug_print("                                 and the power example runs until num fixes.([default: 3])\n");
+
+        return 0;
+    }
+    else if (strcmp("i", type) == 0)
+    {
+        bpc_info_t info;
+
+        /* print bpc info */
+        bpc_info(&info);
+        bpc_interface_debug_print("bpc: chip is %s.\n", info.chip_name);
+        bpc_interface_debug_print("bpc: manufacturer is %s.\n", info.manufacturer_name);
+        bpc_interface_debug_print("bpc: interface is %s.\n", info.interface);
+        bpc_interface_debug_print("bpc: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        bpc_interface_debug_print("bpc: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        bpc_interface_debug_print("bpc: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        bpc_interface_debug_print("bpc: max current is %0.2fmA.\n", info.max_current_ma);
+        bpc_interface_debug_print("bpc: max temperature is %0.1fC.\n", info.temperature_max);
+        bpc_interface_debug_print("bpc: min temperature is %0.1fC.\n", info.temperature_min);
+
+        return 0;
+    }
+    else if (strcmp("p", type) == 0)
+    {
+        /* print pin connection */
+        bpc_interface_debug_print("bpc: INT connected to the simulation edge source.\n");
+
+        return 0;
+    }
+    else
+    {
+        return 5;
+    }
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+    
+    res = bpc(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        bpc_interface_debug_print("bpc: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        bpc_interface_debug_print("bpc: param is invalid.\n");
+    }
+    else
+    {
+        bpc_interface_debug_print("bpc: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
@@ -0,0 +1,751 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      offline.c
+ * @brief     offline decoder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_capture.h"
+#include "capture.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <unistd.h>
+
+/**
+ * @brief offline definition
+ */
+#define OFFLINE_MAX_FILE         256        /**< max capture files */
+#define OFFLINE_MAX_THREAD       256        /**< max worker threads */
+#define OFFLINE_CHUNK_BLOCK      64         /**< default decoded blocks of one chunk */
+#define OFFLINE_WARMUP_BLOCK     4          /**< default warm-up blocks before a chunk */
+
+/**
+ * @brief offline fix structure definition
+ */
+typedef struct offline_fix_s
+{
+    bpc_time_t t;             /**< edge time of the fix */
+    uint32_t file;            /**< file index */
+    bpc_t data;               /**< decoded time */
+} offline_fix_t;
+
+/**
+ * @brief offline chunk structure definition
+ */
+typedef struct offline_chunk_s
+{
+    uint32_t file;                  /**< file index */
+    uint32_t block;                 /**< first decoded block */
+    uint32_t block_end;             /**< block after the last decoded block */
+    offline_fix_t *fix;             /**< fix list */
+    size_t fix_len;                 /**< fix count */
+    size_t fix_size;                /**< fix list size */
+    bpc_stats_t stats;              /**< stats of the decoded blocks */
+    uint32_t baseline_ok;           /**< ok frames of the baseline decoder */
+    uint8_t failed;                 /**< failed flag */
+} offline_chunk_t;
+
+/**
+ * @brief offline deque structure definition
+ */
+typedef struct offline_deque_s
+{
+    pthread_mutex_t mutex;          /**< deque mutex */
+    uint32_t head;                  /**< next own chunk */
+    uint32_t tail;                  /**< chunk after the last chunk */
+} offline_deque_t;
+
+/**
+ * @brief offline worker structure definition
+ */
+typedef struct offline_worker_s
+{
+    uint32_t id;                    /**< worker id */
+    pthread_t pid;                  /**< worker thread */
+    bpc_handle_t handle;            /**< worker decoder */
+    bpc_handle_t baseline;          /**< worker baseline decoder */
+} offline_worker_t;
+
+/**
+ * @brief global var definition
+ */
+static bpc_capture_reader_t gs_reader[OFFLINE_MAX_FILE];          /**< file readers */
+static const uint8_t *gs_buf[OFFLINE_MAX_FILE];                   /**< mapped files */
+static size_t gs_len[OFFLINE_MAX_FILE];                           /**< file lengths */
+static uint32_t gs_file_len;                                      /**< file count */
+static offline_chunk_t *gs_chunk;                                 /**< chunks */
+static uint32_t gs_chunk_len;                                     /**< chunk count */
+static offline_deque_t gs_deque[OFFLINE_MAX_THREAD];              /**< chunk deques */
+static offline_worker_t gs_worker[OFFLINE_MAX_THREAD];            /**< workers */
+static uint32_t gs_thread;                                        /**< worker count */
+static uint32_t gs_warmup = OFFLINE_WARMUP_BLOCK;                 /**< warm-up blocks */
+static bpc_bool_t gs_soft = BPC_BOOL_FALSE;                       /**< soft decision */
+static bpc_bool_t gs_vote = BPC_BOOL_FALSE;                       /**< vote */
+static uint8_t gs_baseline = 0;                                   /**< compare with the hard decision */
+static __thread offline_chunk_t *gs_current;                      /**< chunk of this worker */
+static __thread const bpc_time_t *gs_current_time;                /**< edge of this worker */
+static __thread uint8_t gs_current_keep;                          /**< keep the fixes of this edge */
+
+/**
+ * @brief     offline timestamp read
+ * @param[in] *t pointer to a bpc_time structure
+ * @return    status code
+ *            - 0 success
+ * @note      edges are decoded with their capture time, it is only used by the timing stats
+ */
+static uint8_t a_offline_timestamp_read(bpc_time_t *t)
+{
+    *t = *gs_current_time;
+    
+    return 0;
+}
+
+/**
+ * @brief     offline delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_offline_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     offline print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_offline_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)fputs(str, stderr);
+}
+
+/**
+ * @brief     offline receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      ok fixes of the decoded blocks are saved, the frame errors are in the stats
+ */
+static void a_offline_receive_callback(bpc_t *data)
+{
+    offline_chunk_t *chunk;
+    offline_fix_t *fix;
+    
+    chunk = gs_current;
+    if ((data->status != BPC_STATUS_OK) || (gs_current_keep == 0) || (chunk->failed != 0))
+    {
+        return;
+    }
+    
+    /* grow the fix list */
+    if (chunk->fix_len >= chunk->fix_size)
+    {
+        fix = (offline_fix_t *)realloc(chunk->fix, sizeof(offline_fix_t) * 
+                                       ((chunk->fix_size != 0) ? (chunk->fix_size * 2) : 64));
+        if (fix == NULL)
+        {
+            chunk->failed = 1;
+            
+            return;
+        }
+        chunk->fix = fix;
+        chunk->fix_size = (chunk->fix_size != 0) ? (chunk->fix_size * 2) : 64;
+    }
+    
+    /* save the fix */
+    chunk->fix[chunk->fix_len].t = *gs_current_time;
+    chunk->fix[chunk->fix_len].file = chunk->file;
+    chunk->fix[chunk->fix_len].data = *data;
+    chunk->fix_len++;
+}
+
+/**
+ * @brief     offline baseline receive callback
+ * @param[in] *data pointer to a bpc_t structure
+ * @note      the baseline fixes are only counted in its stats
+ */
+static void a_offline_baseline_callback(bpc_t *data)
+{
+    (void)data;
+}
+
+/**
+ * @brief     offline stats difference
+ * @param[in] *a pointer to the later stats
+ * @param[in] *b pointer to the earlier stats
+ * @param[out] *c pointer to the difference
+ * @note      none
+ */
+static void a_offline_stats_sub(const bpc_stats_t *a, const bpc_stats_t *b, bpc_stats_t *c)
+{
+    c->edge = a->edge - b->edge;
+    c->fifo_full = a->fifo_full - b->fifo_full;
+    c->timeout = a->timeout - b->timeout;
+    c->start_frame = a->start_frame - b->start_frame;
+    c->frame_ok = a->frame_ok - b->frame_ok;
+    c->frame_repaired = a->frame_repaired - b->frame_repaired;
+    c->frame_voted = a->frame_voted - b->frame_voted;
+    c->symbol_invalid = a->symbol_invalid - b->symbol_invalid;
+    c->p1_invalid = a->p1_invalid - b->p1_invalid;
+    c->parity_first = a->parity_first - b->parity_first;
+    c->parity_second = a->parity_second - b->parity_second;
+    c->decode_time_last_us = a->decode_time_last_us;
+    c->decode_time_max_us = a->decode_time_max_us;
+}
+
+/**
+ * @brief     offline decode a chunk
+ * @param[in] *worker pointer to an offline worker structure
+ * @param[in] *chunk pointer to an offline chunk structure
+ * @note      the warm-up blocks before the chunk only restore the decoder state,
+ *            a gap over 3s resets the decoder, so a chunk decodes like the whole file
+ */
+static void a_offline_decode(offline_worker_t *worker, offline_chunk_t *chunk)
+{
+    uint8_t res;
+    bpc_time_t t;
+    bpc_stats_t warm;
+    bpc_stats_t baseline_warm;
+    bpc_stats_t baseline;
+    bpc_capture_reader_t reader;
+    
+    /* a fresh decoder */
+    memset(&t, 0, sizeof(bpc_time_t));
+    gs_current = chunk;
+    gs_current_time = &t;
+    gs_current_keep = 0;
+    DRIVER_BPC_LINK_INIT(&worker->handle, bpc_handle_t);
+    DRIVER_BPC_LINK_TIMESTAMP_READ(&worker->handle, a_offline_timestamp_read);
+    DRIVER_BPC_LINK_DELAY_MS(&worker->handle, a_offline_delay_ms);
+    DRIVER_BPC_LINK_DEBUG_PRINT(&worker->handle, a_offline_debug_print);
+    DRIVER_BPC_LINK_RECEIVE_CALLBACK(&worker->handle, a_offline_receive_callback);
+    if (bpc_init(&worker->handle) != 0)
+    {
+        chunk->failed = 1;
+        
+        return;
+    }
+    (void)bpc_set_soft_decision(&worker->handle, gs_soft);
+    (void)bpc_set_vote(&worker->handle, gs_vote);
+    
+    /* a hard decision decoder on the same edges */
+    if (gs_baseline != 0)
+    {
+        DRIVER_BPC_LINK_INIT(&worker->baseline, bpc_handle_t);
+        DRIVER_BPC_LINK_TIMESTAMP_READ(&worker->baseline, a_offline_timestamp_read);
+        DRIVER_BPC_LINK_DELAY_MS(&worker->baseline, a_offline_delay_ms);
+        DRIVER_BPC_LINK_DEBUG_PRINT(&worker->baseline, a_offline_debug_print);
+        DRIVER_BPC_LINK_RECEIVE_CALLBACK(&worker->baseline, a_offline_baseline_callback);
+        if (bpc_init(&worker->baseline) != 0)
+        {
+            (void)bpc_deinit(&worker->handle);
+            chunk->failed = 1;
+            
+            return;
+        }
+    }
+    
+    /* start at the warm-up blocks */
+    memcpy(&reader, &gs_reader[chunk->file], sizeof(bpc_capture_reader_t));
+    (void)bpc_capture_seek_block(&reader, (chunk->block > gs_warmup) ? (chunk->block - gs_warmup) : 0);
+    memset(&warm, 0, sizeof(bpc_stats_t));
+    memset(&baseline_warm, 0, sizeof(bpc_stats_t));
+    
+    /* decode the edges */
+    while (1)
+    {
+        res = bpc_capture_read(&reader, &t);
+        if (res == 1)
+        {
+            break;
+        }
+        if (res != 0)
+        {
+            a_offline_debug_print("offline: file %u block %u is invalid.\n", chunk->file, reader.block);
+            chunk->failed = 1;
+            
+            break;
+        }
+        if (reader.block >= chunk->block_end)
+        {
+            break;
+        }
+        if ((gs_current_keep == 0) && (reader.block >= chunk->block))
+        {
+            /* the stats of the chunk start here */
+            (void)bpc_get_stats(&worker->handle, &warm);
+            if (gs_baseline != 0)
+            {
+                (void)bpc_get_stats(&worker->baseline, &baseline_warm);
+            }
+            gs_current_keep = 1;
+        }
+        (void)bpc_irq_handler_at(&worker->handle, &t);
+        if (gs_baseline != 0)
+        {
+            (void)bpc_irq_handler_at(&worker->baseline, &t);
+        }
+    }
+    (void)bpc_get_stats(&worker->handle, &chunk->stats);
+    a_offline_stats_sub(&chunk->stats, &warm, &chunk->stats);
+    (void)bpc_deinit(&worker->handle);
+    if (gs_baseline != 0)
+    {
+        (void)bpc_get_stats(&worker->baseline, &baseline);
+        chunk->baseline_ok = baseline.frame_ok - baseline_warm.frame_ok;
+        (void)bpc_deinit(&worker->baseline);
+    }
+}
+
+/**
+ * @brief      offline take a chunk
+ * @param[in]  id worker id
+ * @param[out] *chunk pointer to a chunk index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no chunk is left
+ * @note       a worker takes its own chunks from the head and steals from the tail of the others
+ */
+static uint8_t a_offline_take(uint32_t id, uint32_t *chunk)
+{
+    uint32_t i;
+    offline_deque_t *deque;
+    
+    for (i = 0; i < gs_thread; i++)
+    {
+        deque = &gs_deque[(id + i) % gs_thread];
+        (void)pthread_mutex_lock(&deque->mutex);
+        if (deque->head < deque->tail)
+        {
+            if (i == 0)
+            {
+                *chunk = deque->head++;
+            }
+            else
+            {
+                *chunk = --deque->tail;
+            }
+            (void)pthread_mutex_unlock(&deque->mutex);
+            
+            return 0;
+        }
+        (void)pthread_mutex_unlock(&deque->mutex);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  offline worker pthread
+ * @param  *p pointer to an offline worker structure
+ * @return NULL
+ * @note   none
+ */
+static void *a_offline_worker_pthread(void *p)
+{
+    uint32_t chunk;
+    offline_worker_t *worker;
+    
+    worker = (offline_worker_t *)p;
+    while (a_offline_take(worker->id, &chunk) == 0)
+    {
+        a_offline_decode(worker, &gs_chunk[chunk]);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     offline fix compare
+ * @param[in] *a pointer to a fix
+ * @param[in] *b pointer to a fix
+ * @return    compare result
+ * @note      fixes are ordered by time, then by file
+ */
+static int a_offline_fix_compare(const void *a, const void *b)
+{
+    const offline_fix_t *x = (const offline_fix_t *)a;
+    const offline_fix_t *y = (const offline_fix_t *)b;
+    
+    if (x->t.s != y->t.s)
+    {
+        return (x->t.s < y->t.s) ? -1 : 1;
+    }
+    if (x->t.us != y->t.us)
+    {
+        return (x->t.us < y->t.us) ? -1 : 1;
+    }
+    if (x->file != y->file)
+    {
+        return (x->file < y->file) ? -1 : 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     offline main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    uint32_t chunk_block = OFFLINE_CHUNK_BLOCK;
+    uint64_t edge;
+    size_t fix_len;
+    offline_fix_t *fix;
+    bpc_stats_t stats;
+    uint64_t sum[9];
+    uint64_t baseline_ok;
+    FILE *output = stdout;
+    struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"threads", required_argument, NULL, 1},
+        {"chunk", required_argument, NULL, 2},
+        {"warmup", required_argument, NULL, 3},
+        {"soft", no_argument, NULL, 4},
+        {"vote", no_argument, NULL, 5},
+        {"output", required_argument, NULL, 6},
+        {"baseline", no_argument, NULL, 7},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* default threads */
+    gs_thread = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                (void)printf("Usage:\n");
+                (void)printf("  bpc_offline [--threads=<num>] [--chunk=<blocks>] [--warmup=<blocks>] [--soft] [--vote]\n");
+                (void)printf("              [--baseline] [--output=<path>] <capture>...\n");
+                (void)printf("\n");
+                (void)printf("Options:\n");
+                (void)printf("      --baseline                 Fail if the hard decision decodes more ok frames.\n");
+                (void)printf("      --chunk=<blocks>           Set the decoded blocks of one chunk.([default: 64])\n");
+                (void)printf("  -h, --help                     Show the help.\n");
+                (void)printf("      --output=<path>            Set the fix list file.([default: stdout])\n");
+                (void)printf("      --soft                     Enable the soft decision.\n");
+                (void)printf("      --threads=<num>            Set the worker threads.([default: online cpus])\n");
+                (void)printf("      --vote                     Enable the vote.\n");
+                (void)printf("      --warmup=<blocks>          Set the warm-up blocks before a chunk.([default: 4])\n");
+                
+                return 0;
+            }
+            
+            /* threads */
+            case 1 :
+            {
+                gs_thread = (uint32_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            
+            /* chunk blocks */
+            case 2 :
+            {
+                chunk_block = (uint32_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            
+            /* warm-up blocks */
+            case 3 :
+            {
+                gs_warmup = (uint32_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            
+            /* soft decision */
+            case 4 :
+            {
+                gs_soft = BPC_BOOL_TRUE;
+                
+                break;
+            }
+            
+            /* vote */
+            case 5 :
+            {
+                gs_vote = BPC_BOOL_TRUE;
+                
+                break;
+            }
+            
+            /* output */
+            case 6 :
+            {
+                output = fopen(optarg, "w");
+                if (output == NULL)
+                {
+                    perror("offline: open failed.\n");
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            
+            /* baseline */
+            case 7 :
+            {
+                gs_baseline = 1;
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    
+    /* check the params */
+    if ((optind >= argc) || ((argc - optind) > OFFLINE_MAX_FILE) || 
+        (gs_thread == 0) || (gs_thread > OFFLINE_MAX_THREAD) || (chunk_block == 0))
+    {
+        (void)fprintf(stderr, "offline: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* map the files */
+    res = 0;
+    gs_file_len = 0;
+    gs_chunk_len = 0;
+    for (i = 0; i < (uint32_t)(argc - optind); i++)
+    {
+        if (capture_map(argv[optind + i], &gs_buf[i], &gs_len[i]) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+        gs_file_len++;
+        if (bpc_capture_reader_init(&gs_reader[i], gs_buf[i], gs_len[i]) != 0)
+        {
+            (void)fprintf(stderr, "offline: %s is invalid.\n", argv[optind + i]);
+            res = 1;
+            
+            break;
+        }
+        gs_chunk_len += (gs_reader[i].header.block_count + chunk_block - 1) / chunk_block;
+    }
+    
+    /* split the files into chunks */
+    if (res == 0)
+    {
+        gs_chunk = (offline_chunk_t *)calloc((gs_chunk_len != 0) ? gs_chunk_len : 1, sizeof(offline_chunk_t));
+        if (gs_chunk == NULL)
+        {
+            res = 1;
+        }
+    }
+    if (res == 0)
+    {
+        n = 0;
+        for (i = 0; i < gs_file_len; i++)
+        {
+            for (j = 0; j < gs_reader[i].header.block_count; j += chunk_block)
+            {
+                gs_chunk[n].file = i;
+                gs_chunk[n].block = j;
+                gs_chunk[n].block_end = ((gs_reader[i].header.block_count - j) > chunk_block) ? 
+                                        (j + chunk_block) : gs_reader[i].header.block_count;
+                n++;
+            }
+        }
+        
+        /* every worker owns a run of neighbouring chunks */
+        for (i = 0; i < gs_thread; i++)
+        {
+            (void)pthread_mutex_init(&gs_deque[i].mutex, NULL);
+            gs_deque[i].head = (uint32_t)((uint64_t)gs_chunk_len * i / gs_thread);
+            gs_deque[i].tail = (uint32_t)((uint64_t)gs_chunk_len * (i + 1) / gs_thread);
+        }
+        
+        /* run the workers */
+        for (i = 0; i < gs_thread; i++)
+        {
+            gs_worker[i].id = i;
+            if (pthread_create(&gs_worker[i].pid, NULL, a_offline_worker_pthread, &gs_worker[i]) != 0)
+            {
+                perror("offline: creat pthread failed.\n");
+                res = 1;
+                
+                break;
+            }
+        }
+        for (j = 0; j < i; j++)
+        {
+            (void)pthread_join(gs_worker[j].pid, NULL);
+        }
+        for (i = 0; i < gs_thread; i++)
+        {
+            (void)pthread_mutex_destroy(&gs_deque[i].mutex);
+        }
+    }
+    
+    /* merge the fixes in time order */
+    fix = NULL;
+    fix_len = 0;
+    memset(sum, 0, sizeof(sum));
+    baseline_ok = 0;
+    edge = 0;
+    if (res == 0)
+    {
+        for (i = 0; i < gs_chunk_len; i++)
+        {
+            if (gs_chunk[i].failed != 0)
+            {
+                res = 1;
+            }
+            fix_len += gs_chunk[i].fix_len;
+        }
+        fix = (offline_fix_t *)malloc(sizeof(offline_fix_t) * ((fix_len != 0) ? fix_len : 1));
+        if (fix == NULL)
+        {
+            res = 1;
+        }
+    }
+    if (fix != NULL)
+    {
+        fix_len = 0;
+        for (i = 0; i < gs_chunk_len; i++)
+        {
+            memcpy(&fix[fix_len], gs_chunk[i].fix, sizeof(offline_fix_t) * gs_chunk[i].fix_len);
+            fix_len += gs_chunk[i].fix_len;
+            stats = gs_chunk[i].stats;
+            edge += stats.edge;
+            sum[0] += stats.timeout;
+            sum[1] += stats.start_frame;
+            sum[2] += stats.frame_ok;
+            sum[3] += stats.frame_repaired;
+            sum[4] += stats.frame_voted;
+            sum[5] += stats.symbol_invalid;
+            sum[6] += stats.p1_invalid;
+            sum[7] += stats.parity_first;
+            sum[8] += stats.parity_second;
+            baseline_ok += gs_chunk[i].baseline_ok;
+        }
+        if (gs_file_len > 1)
+        {
+            qsort(fix, fix_len, sizeof(offline_fix_t), a_offline_fix_compare);
+        }
+        
+        /* output the fix list */
+        (void)fprintf(output, "edge_s,edge_us,file,date,time,week,confidence,repair\n");
+        for (i = 0; i < fix_len; i++)
+        {
+            (void)fprintf(output, "%llu,%06u,%u,%04d-%02d-%02d,%02d:%02d:%02d,%d,%d,%d\n", 
+                          (unsigned long long)fix[i].t.s, fix[i].t.us, fix[i].file,
+                          fix[i].data.year, fix[i].data.month, fix[i].data.day,
+                          fix[i].data.hour, fix[i].data.minute, fix[i].data.second,
+                          fix[i].data.week, fix[i].data.confidence, fix[i].data.repair);
+        }
+        
+        /* output the stats */
+        (void)fprintf(stderr, "offline: %u files, %u chunks, %u threads.\n", gs_file_len, gs_chunk_len, gs_thread);
+        (void)fprintf(stderr, "offline: %llu edges, %llu timeouts, %llu start frames.\n", 
+                      (unsigned long long)edge, (unsigned long long)sum[0], (unsigned long long)sum[1]);
+        (void)fprintf(stderr, "offline: %llu frames ok, %llu repaired, %llu voted.\n", 
+                      (unsigned long long)sum[2], (unsigned long long)sum[3], (unsigned long long)sum[4]);
+        (void)fprintf(stderr, "offline: %llu symbol invalid, %llu p1 invalid, %llu first parity, %llu second parity.\n", 
+                      (unsigned long long)sum[5], (unsigned long long)sum[6], 
+                      (unsigned long long)sum[7], (unsigned long long)sum[8]);
+        if (gs_baseline != 0)
+        {
+            (void)fprintf(stderr, "offline: %llu frames ok with the hard decision.\n", (unsigned long long)baseline_ok);
+            if (sum[2] < baseline_ok)
+            {
+                (void)fprintf(stderr, "offline: fewer frames than the hard decision.\n");
+                res = 1;
+            }
+        }
+        free(fix);
+    }
+    
+    /* free all */
+    if (gs_chunk != NULL)
+    {
+        for (i = 0; i < gs_chunk_len; i++)
+        {
+            free(gs_chunk[i].fix);
+        }
+        free(gs_chunk);
+    }
+    for (i = 0; i < gs_file_len; i++)
+    {
+        (void)capture_unmap(gs_buf[i], gs_len[i]);
+    }
+    if (output != stdout)
+    {
+        (void)fclose(output);
+    }
+    
+    return (res == 0) ? 0 : 1;
+}
@@ -38,12 +38,13 @@
 #include "delay.h"
 #include "uart.h"
 #include "tim.h"
+#include "gpio.h"
 #include <stdarg.h>
 
 /**
  * @brief timer var definition
  */
-static uint64_t gs_second = 0;        /**< second */
+static volatile uint32_t gs_overflow = 0;        /**< TIM2 overflow count, the high word of the tick */
 
 /**
  * @brief     timer callback
@@ -52,7 +53,38 @@ static uint64_t gs_second = 0;        /**< second */
  */
 static void gs_tim_irq(uint32_t us)
 {
-    gs_second += us / 1000000;
+    (void)us;
+    
+    gs_overflow++;
+}
+
+/**
+ * @brief  read the 64 bit tick
+ * @return tick in us
+ * @note   it is lock free and never disables the interrupt, an overflow which is pending but not counted
+ *         yet is detected by the update flag, the caller mustn't preempt the TIM2 irq
+ */
+static inline uint64_t a_tick_read(void)
+{
+    TIM_TypeDef *tim;
+    uint32_t high;
+    uint32_t low;
+    uint32_t check;
+    
+    tim = tim_get_handle()->Instance;
+    do
+    {
+        high = gs_overflow;                                /* read the high word */
+        low = tim->CNT;                                    /* read the low word */
+        if ((tim->SR & TIM_SR_UIF) != 0)                   /* an overflow is pending */
+        {
+            low = tim->CNT;                                /* the counter after the overflow */
+            high++;                                        /* count the pending overflow */
+        }
+        check = gs_overflow;                               /* read the high word again */
+    } while ((high != check) && (high != check + 1));      /* the irq ran meanwhile, read again */
+    
+    return ((uint64_t)high << 32) | low;
 }
 
 /**
@@ -60,12 +92,12 @@ static void gs_tim_irq(uint32_t us)
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   TIM2 is a free running 32 bit counter at 1MHz
  */
 uint8_t bpc_interface_timer_init(void)
 {
     /* timer init */
-    if (tim_init(1000000, gs_tim_irq) != 0)
+    if (tim_counter_init(gs_tim_irq) != 0)
     {
         return 1;
     }
@@ -89,8 +121,41 @@ uint8_t bpc_interface_timer_init(void)
  */
 uint8_t bpc_interface_timestamp_read(bpc_time_t *t)
 {
-    t->s = gs_second;
-    t->us = tim_get_handle()->Instance->CNT;
+    uint64_t tick;
+    
+    tick = a_tick_read();
+    t->s = tick / 1000000ULL;
+    t->us = (uint32_t)(tick % 1000000ULL);
+    
+    return 0;
+}
+
+/**
+ * @brief      interface convert captured timer counts to timestamps
+ * @param[in]  *count pointer to a captured TIM2 count buffer
+ * @param[in]  len count buffer length
+ * @param[out] *t pointer to a bpc_time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 convert failed
+ * @note       every count must be captured less than one timer period ago
+ */
+uint8_t bpc_interface_timestamp_from_count(const uint32_t *count, uint16_t len, bpc_time_t *t)
+{
+    uint16_t i;
+    uint64_t now;
+    uint64_t edge;
+    
+    /* read now after the counts are captured */
+    now = a_tick_read();
+    
+    for (i = 0; i < len; i++)
+    {
+        /* the capture age wraps with the low word */
+        edge = now - (uint32_t)((uint32_t)now - count[i]);
+        t[i].s = edge / 1000000ULL;
+        t[i].us = (uint32_t)(edge % 1000000ULL);
+    }
     
     return 0;
 }
@@ -105,6 +170,36 @@ void bpc_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface sleep ms
+ * @param[in] ms time
+ * @note      the core sleeps until the systick or an edge interrupt, the stop mode would halt TIM2,
+ *            the time base of the decoder
+ */
+void bpc_interface_sleep_ms(uint32_t ms)
+{
+    uint32_t start;
+    
+    start = HAL_GetTick();
+    while ((HAL_GetTick() - start) < ms)
+    {
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
+}
+
+/**
+ * @brief     interface receiver power
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ *            - 1 power failed
+ * @note      the PON pin is PB1 and the exti input is masked while the receiver is off
+ */
+uint8_t bpc_interface_power(uint8_t enable)
+{
+    return gpio_power_write(enable);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -65,6 +65,31 @@ uint8_t gpio_interrupt_init(void);
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief  gpio power init
+ * @return status code
+ *         - 0 success
+ * @note   gpio pin is PB1, the receiver is off after the init
+ */
+uint8_t gpio_power_init(void);
+
+/**
+ * @brief  gpio power deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_power_deinit(void);
+
+/**
+ * @brief     gpio power write
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ * @note      PON is low active, the PB0 exti is masked while the receiver is off
+ */
+uint8_t gpio_power_write(uint8_t enable);
+
 /**
  * @}
  */
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ic.h
+ * @brief     ic header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef IC_H
+#define IC_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ic ic function
+ * @brief    ic function modules
+ * @{
+ */
+
+/**
+ * @brief ic buffer size definition
+ */
+#define IC_BUFFER_SIZE 64             /**< dma circular buffer length in captures */
+#define IC_FLUSH_PERIOD 1000000       /**< longest capture wait in us before it is handed over */
+
+/**
+ * @brief     input capture init
+ * @param[in] *ic_irq pointer to an input capture irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      input pin is PB10(TIM2_CH3), both edges are captured by dma into a circular buffer,
+ *            the TIM2_CH4 compare irq hands the captures over when the dma is slow,
+ *            call it after the TIM2 time base is started
+ */
+uint8_t ic_init(void (*ic_irq)(const uint32_t *count, uint16_t len));
+
+/**
+ * @brief  input capture deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ic_deinit(void);
+
+/**
+ * @brief  get the dma handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* ic_get_dma_handle(void);
+
+/**
+ * @brief input capture irq handler
+ * @note  it hands all new captures to the irq function, call it from the dma half and full
+ *        transfer callbacks, the TIM2_CH4 compare callback and at least once per TIM2 period
+ *        at the same priority, no capture waits longer than IC_FLUSH_PERIOD
+ */
+void ic_irq_handler(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pwm.h
+ * @brief     pwm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef PWM_H
+#define PWM_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup pwm pwm function
+ * @brief    pwm function modules
+ * @{
+ */
+
+/**
+ * @brief     pwm input init
+ * @param[in] *pwm_irq pointer to a pwm input irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      input pin is PA0(TIM5_CH1), the falling edge resets TIM5 and captures the period,
+ *            the rising edge captures the low pulse width, the irq runs once per falling edge
+ *            with the TIM2 count of that edge, call it after the TIM2 time base is started
+ */
+uint8_t pwm_init(void (*pwm_irq)(uint32_t count, uint32_t width, uint32_t period));
+
+/**
+ * @brief  pwm input deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t pwm_deinit(void);
+
+/**
+ * @brief  get the tim handle
+ * @return pointer to a tim handle
+ * @note   none
+ */
+TIM_HandleTypeDef* pwm_get_handle(void);
+
+/**
+ * @brief pwm input irq handler
+ * @note  call it from the TIM5 channel 1 capture callback
+ */
+void pwm_irq_handler(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -61,6 +61,16 @@
  */
 uint8_t tim_init(uint32_t us, void (*tim_irq)(uint32_t us));
 
+/**
+ * @brief     timer free running counter init
+ * @param[in] *tim_irq pointer to a timer irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the 32 bit counter counts at 1MHz and the irq runs on every overflow with us 0
+ */
+uint8_t tim_counter_init(void (*tim_irq)(uint32_t us));
+
 /**
  * @brief  timer deint
  * @return status code
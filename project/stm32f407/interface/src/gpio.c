@@ -79,3 +79,74 @@ uint8_t gpio_interrupt_deinit(void)
     
     return 0;
 }
+
+/**
+ * @brief  gpio power init
+ * @return status code
+ *         - 0 success
+ * @note   gpio pin is PB1, the receiver is off after the init
+ */
+uint8_t gpio_power_init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    /* enable gpio clock */
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    
+    /* PON high powers the receiver off */
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_1, GPIO_PIN_SET);
+    
+    /* gpio init */
+    GPIO_InitStruct.Pin = GPIO_PIN_1;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio power deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_power_deinit(void)
+{
+    /* gpio deinit */
+    HAL_GPIO_DeInit(GPIOB, GPIO_PIN_1);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio power write
+ * @param[in] enable 1 powers the receiver on, 0 powers it off
+ * @return    status code
+ *            - 0 success
+ * @note      PON is low active, the PB0 exti is masked while the receiver is off
+ */
+uint8_t gpio_power_write(uint8_t enable)
+{
+    if (enable != 0)
+    {
+        /* power on */
+        HAL_GPIO_WritePin(GPIOB, GPIO_PIN_1, GPIO_PIN_RESET);
+        
+        /* drop the edges of the power off time */
+        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_0);
+        HAL_NVIC_ClearPendingIRQ(EXTI0_IRQn);
+        HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+    }
+    else
+    {
+        /* mask the edges */
+        HAL_NVIC_DisableIRQ(EXTI0_IRQn);
+        
+        /* power off */
+        HAL_GPIO_WritePin(GPIOB, GPIO_PIN_1, GPIO_PIN_SET);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ic.c
+ * @brief     ic source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ic.h"
+#include "tim.h"
+
+/**
+ * @brief ic var definition
+ */
+static DMA_HandleTypeDef gs_dma_handle;                                 /**< dma handle */
+static uint32_t gs_buffer[IC_BUFFER_SIZE];                              /**< dma circular buffer */
+static uint16_t gs_read;                                                /**< read position */
+static void (*gs_ic_irq)(const uint32_t *count, uint16_t len) = NULL;   /**< ic irq */
+
+/**
+ * @brief     input capture init
+ * @param[in] *ic_irq pointer to an input capture irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      input pin is PB10(TIM2_CH3), both edges are captured by dma into a circular buffer,
+ *            the TIM2_CH4 compare irq hands the captures over when the dma is slow,
+ *            call it after the TIM2 time base is started
+ */
+uint8_t ic_init(void (*ic_irq)(const uint32_t *count, uint16_t len))
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    TIM_IC_InitTypeDef TIM_IC_InitStruct;
+    TIM_OC_InitTypeDef TIM_OC_InitStruct;
+    TIM_HandleTypeDef *htim;
+    
+    /* get the TIM2 handle */
+    htim = tim_get_handle();
+    
+    /* enable gpio and dma clock */
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    
+    /* gpio init */
+    GPIO_InitStruct.Pin = GPIO_PIN_10;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF1_TIM2;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+    
+    /* TIM2_CH3 is dma1 stream1 channel3 */
+    gs_dma_handle.Instance = DMA1_Stream1;
+    gs_dma_handle.Init.Channel = DMA_CHANNEL_3;
+    gs_dma_handle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    gs_dma_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    gs_dma_handle.Init.MemInc = DMA_MINC_ENABLE;
+    gs_dma_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    gs_dma_handle.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    gs_dma_handle.Init.Mode = DMA_CIRCULAR;
+    gs_dma_handle.Init.Priority = DMA_PRIORITY_HIGH;
+    gs_dma_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&gs_dma_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    __HAL_LINKDMA(htim, hdma[TIM_DMA_ID_CC3], gs_dma_handle);
+    
+    /* the same priority as TIM2 keeps the irq handler unnested */
+    HAL_NVIC_SetPriority(DMA1_Stream1_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream1_IRQn);
+    
+    /* capture both edges, the filter rejects glitches shorter than about 3us */
+    TIM_IC_InitStruct.ICPolarity = TIM_INPUTCHANNELPOLARITY_BOTHEDGE;
+    TIM_IC_InitStruct.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    TIM_IC_InitStruct.ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_IC_InitStruct.ICFilter = 0x0F;
+    if (HAL_TIM_IC_ConfigChannel(htim, &TIM_IC_InitStruct, TIM_CHANNEL_3) != HAL_OK)
+    {
+        HAL_NVIC_DisableIRQ(DMA1_Stream1_IRQn);
+        (void)HAL_DMA_DeInit(&gs_dma_handle);
+        
+        return 1;
+    }
+    
+    /* the TIM2_CH4 compare only raises the flush irq, its output stays disabled */
+    TIM_OC_InitStruct.OCMode = TIM_OCMODE_TIMING;
+    TIM_OC_InitStruct.Pulse = __HAL_TIM_GET_COUNTER(htim) + IC_FLUSH_PERIOD;
+    TIM_OC_InitStruct.OCPolarity = TIM_OCPOLARITY_HIGH;
+    TIM_OC_InitStruct.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+    TIM_OC_InitStruct.OCFastMode = TIM_OCFAST_DISABLE;
+    TIM_OC_InitStruct.OCIdleState = TIM_OCIDLESTATE_RESET;
+    TIM_OC_InitStruct.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+    if (HAL_TIM_OC_ConfigChannel(htim, &TIM_OC_InitStruct, TIM_CHANNEL_4) != HAL_OK)
+    {
+        HAL_NVIC_DisableIRQ(DMA1_Stream1_IRQn);
+        (void)HAL_DMA_DeInit(&gs_dma_handle);
+        
+        return 1;
+    }
+    
+    /* set the ic callback */
+    gs_read = 0;
+    gs_ic_irq = ic_irq;
+    
+    /* start the capture */
+    if (HAL_TIM_IC_Start_DMA(htim, TIM_CHANNEL_3, gs_buffer, IC_BUFFER_SIZE) != HAL_OK)
+    {
+        gs_ic_irq = NULL;
+        HAL_NVIC_DisableIRQ(DMA1_Stream1_IRQn);
+        (void)HAL_DMA_DeInit(&gs_dma_handle);
+        
+        return 1;
+    }
+    
+    /* start the flush irq */
+    __HAL_TIM_CLEAR_IT(htim, TIM_IT_CC4);
+    __HAL_TIM_ENABLE_IT(htim, TIM_IT_CC4);
+    
+    return 0;
+}
+
+/**
+ * @brief  input capture deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ic_deinit(void)
+{
+    /* stop the flush irq */
+    __HAL_TIM_DISABLE_IT(tim_get_handle(), TIM_IT_CC4);
+    
+    /* stop the capture, the TIM2 time base keeps running */
+    if (HAL_TIM_IC_Stop_DMA(tim_get_handle(), TIM_CHANNEL_3) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(DMA1_Stream1_IRQn);
+    
+    /* dma deinit */
+    if (HAL_DMA_DeInit(&gs_dma_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* gpio deinit */
+    HAL_GPIO_DeInit(GPIOB, GPIO_PIN_10);
+    
+    /* set ic irq NULL */
+    gs_ic_irq = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief  get the dma handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* ic_get_dma_handle(void)
+{
+    return &gs_dma_handle;
+}
+
+/**
+ * @brief input capture irq handler
+ * @note  it hands all new captures to the irq function, call it from the dma half and full
+ *        transfer callbacks, the TIM2_CH4 compare callback and at least once per TIM2 period
+ *        at the same priority, no capture waits longer than IC_FLUSH_PERIOD
+ */
+void ic_irq_handler(void)
+{
+    uint16_t write;
+    TIM_HandleTypeDef *htim;
+    
+    /* check the ic irq */
+    if (gs_ic_irq == NULL)
+    {
+        return;
+    }
+    
+    /* the next flush is one period after this hand over */
+    htim = tim_get_handle();
+    __HAL_TIM_SET_COMPARE(htim, TIM_CHANNEL_4, __HAL_TIM_GET_COUNTER(htim) + IC_FLUSH_PERIOD);
+    
+    /* get the dma write position */
+    write = (uint16_t)(IC_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(&gs_dma_handle));
+    if (write >= IC_BUFFER_SIZE)
+    {
+        write = 0;
+    }
+    
+    /* the wrapped part first */
+    if (write < gs_read)
+    {
+        gs_ic_irq(&gs_buffer[gs_read], (uint16_t)(IC_BUFFER_SIZE - gs_read));
+        gs_read = 0;
+    }
+    
+    /* the linear part */
+    if (write > gs_read)
+    {
+        gs_ic_irq(&gs_buffer[gs_read], (uint16_t)(write - gs_read));
+        gs_read = write;
+    }
+}
@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pwm.c
+ * @brief     pwm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "pwm.h"
+
+/**
+ * @brief pwm var definition
+ */
+static TIM_HandleTypeDef gs_tim_handle;                                                /**< tim handle */
+static uint8_t gs_first;                                                               /**< first capture flag */
+static void (*gs_pwm_irq)(uint32_t count, uint32_t width, uint32_t period) = NULL;    /**< pwm irq */
+
+/**
+ * @brief     pwm input init
+ * @param[in] *pwm_irq pointer to a pwm input irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      input pin is PA0(TIM5_CH1), the falling edge resets TIM5 and captures the period,
+ *            the rising edge captures the low pulse width, the irq runs once per falling edge
+ *            with the TIM2 count of that edge, call it after the TIM2 time base is started
+ */
+uint8_t pwm_init(void (*pwm_irq)(uint32_t count, uint32_t width, uint32_t period))
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    TIM_IC_InitTypeDef TIM_IC_InitStruct;
+    TIM_SlaveConfigTypeDef TIM_SlaveConfigStruct;
+    
+    /* enable gpio and tim clock */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_TIM5_CLK_ENABLE();
+    
+    /* gpio init */
+    GPIO_InitStruct.Pin = GPIO_PIN_0;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF2_TIM5;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    
+    /* TIM5 is 32 bit and counts at 1MHz like TIM2 */
+    gs_tim_handle.Instance = TIM5;
+    gs_tim_handle.Init.Prescaler = ((SystemCoreClock / 2) / 1000000) - 1;
+    gs_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    gs_tim_handle.Init.Period = 0xFFFFFFFFU;
+    gs_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    if (HAL_TIM_IC_Init(&gs_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* channel 1 captures the period on the falling edge, the filter rejects glitches shorter than about 3us */
+    TIM_IC_InitStruct.ICPolarity = TIM_INPUTCHANNELPOLARITY_FALLING;
+    TIM_IC_InitStruct.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    TIM_IC_InitStruct.ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_IC_InitStruct.ICFilter = 0x0F;
+    if (HAL_TIM_IC_ConfigChannel(&gs_tim_handle, &TIM_IC_InitStruct, TIM_CHANNEL_1) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* channel 2 captures the low pulse width on the rising edge of the same pin */
+    TIM_IC_InitStruct.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+    TIM_IC_InitStruct.ICSelection = TIM_ICSELECTION_INDIRECTTI;
+    if (HAL_TIM_IC_ConfigChannel(&gs_tim_handle, &TIM_IC_InitStruct, TIM_CHANNEL_2) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* the falling edge resets the counter */
+    TIM_SlaveConfigStruct.SlaveMode = TIM_SLAVEMODE_RESET;
+    TIM_SlaveConfigStruct.InputTrigger = TIM_TS_TI1FP1;
+    TIM_SlaveConfigStruct.TriggerPolarity = TIM_TRIGGERPOLARITY_FALLING;
+    TIM_SlaveConfigStruct.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+    TIM_SlaveConfigStruct.TriggerFilter = 0x0F;
+    if (HAL_TIM_SlaveConfigSynchro(&gs_tim_handle, &TIM_SlaveConfigStruct) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* the same priority as TIM2 keeps the irq handler unnested */
+    HAL_NVIC_SetPriority(TIM5_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+    
+    /* set the pwm callback */
+    gs_first = 1;
+    gs_pwm_irq = pwm_irq;
+    
+    /* only the period capture raises an irq */
+    if (HAL_TIM_IC_Start(&gs_tim_handle, TIM_CHANNEL_2) != HAL_OK)
+    {
+        gs_pwm_irq = NULL;
+        HAL_NVIC_DisableIRQ(TIM5_IRQn);
+        
+        return 1;
+    }
+    if (HAL_TIM_IC_Start_IT(&gs_tim_handle, TIM_CHANNEL_1) != HAL_OK)
+    {
+        (void)HAL_TIM_IC_Stop(&gs_tim_handle, TIM_CHANNEL_2);
+        gs_pwm_irq = NULL;
+        HAL_NVIC_DisableIRQ(TIM5_IRQn);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  pwm input deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t pwm_deinit(void)
+{
+    /* stop the capture */
+    if (HAL_TIM_IC_Stop_IT(&gs_tim_handle, TIM_CHANNEL_1) != HAL_OK)
+    {
+        return 1;
+    }
+    if (HAL_TIM_IC_Stop(&gs_tim_handle, TIM_CHANNEL_2) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(TIM5_IRQn);
+    
+    /* tim deinit */
+    if (HAL_TIM_IC_DeInit(&gs_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    __HAL_RCC_TIM5_CLK_DISABLE();
+    
+    /* gpio deinit */
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_0);
+    
+    /* set pwm irq NULL */
+    gs_pwm_irq = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief  get the tim handle
+ * @return pointer to a tim handle
+ * @note   none
+ */
+TIM_HandleTypeDef* pwm_get_handle(void)
+{
+    return &gs_tim_handle;
+}
+
+/**
+ * @brief pwm input irq handler
+ * @note  call it from the TIM5 channel 1 capture callback
+ */
+void pwm_irq_handler(void)
+{
+    uint32_t count;
+    uint32_t period;
+    uint32_t width;
+    
+    /* the time since the falling edge is the TIM5 count, both timers run at 1MHz */
+    count = TIM2->CNT - TIM5->CNT;
+    period = HAL_TIM_ReadCapturedValue(&gs_tim_handle, TIM_CHANNEL_1);
+    width = HAL_TIM_ReadCapturedValue(&gs_tim_handle, TIM_CHANNEL_2);
+    
+    /* the first period starts at the init, not at an edge */
+    if (gs_first != 0)
+    {
+        gs_first = 0;
+        
+        return;
+    }
+    
+    /* run the pwm irq */
+    if (gs_pwm_irq != NULL)
+    {
+        gs_pwm_irq(count, width, period);
+    }
+}
@@ -87,6 +87,46 @@ uint8_t tim_init(uint32_t us, void (*tim_irq)(uint32_t us))
     return 0;
 }
 
+/**
+ * @brief     timer free running counter init
+ * @param[in] *tim_irq pointer to a timer irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the 32 bit counter counts at 1MHz and the irq runs on every overflow with us 0
+ */
+uint8_t tim_counter_init(void (*tim_irq)(uint32_t us))
+{
+    /* use TIM2 */
+    gs_tim_handle.Instance = TIM2;
+    
+    /* set the prescaler */
+    gs_tim_handle.Init.Prescaler = ((SystemCoreClock / 2) / 1000000) - 1;
+    
+    /* up counter mode */
+    gs_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    
+    /* use the full 32 bit range */
+    gs_tim_handle.Init.Period = 0xFFFFFFFFU;
+    
+    /* div 1 */
+    gs_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    
+    /* time base init */
+    if (HAL_TIM_Base_Init(&gs_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* the init update event is not an overflow */
+    __HAL_TIM_CLEAR_FLAG(&gs_tim_handle, TIM_FLAG_UPDATE);
+    
+    /* set the timer callback */
+    gs_tim_irq = tim_irq;
+    
+    return 0;
+}
+
 /**
  * @brief  timer deint
  * @return status code
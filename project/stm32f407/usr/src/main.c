@@ -35,11 +35,14 @@
  */
 
 #include "driver_bpc_basic.h"
+#include "driver_bpc_power.h"
 #include "driver_bpc_receive_test.h"
 #include "shell.h"
 #include "clock.h"
 #include "delay.h"
 #include "gpio.h"
+#include "ic.h"
+#include "pwm.h"
 #include "uart.h"
 #include "getopt.h"
 #include <stdlib.h>
@@ -50,8 +53,13 @@
 uint8_t g_buf[256];                                   /**< uart buffer */
 volatile uint16_t g_len;                              /**< uart buffer length */
 volatile uint8_t g_flag;                              /**< interrupt flag */
-uint8_t (*g_gpio_irq)(void) = NULL;                   /**< gpio irq */
-extern uint8_t bpc_interface_timer_init(void);        /**< timer init function */
+uint8_t (*g_gpio_irq)(void) = NULL;                                                        /**< gpio irq */
+uint8_t (*g_ic_irq)(const bpc_time_t *t, size_t n) = NULL;                                 /**< input capture irq */
+uint8_t (*g_pwm_irq)(const bpc_time_t *t, uint32_t width_us, uint32_t period_us) = NULL;   /**< pwm input irq */
+static bpc_time_t gs_ic_time[IC_BUFFER_SIZE];                                             /**< input capture time buffer */
+extern uint8_t bpc_interface_timer_init(void);                                             /**< timer init function */
+extern uint8_t bpc_interface_timestamp_from_count(const uint32_t *count, uint16_t len, 
+                                                  bpc_time_t *t);                          /**< timestamp convert function */
 
 /**
  * @brief exti 0 irq
@@ -79,6 +87,134 @@ void HAL_GPIO_EXTI_Callback(uint16_t pin)
     }
 }
 
+/**
+ * @brief     input capture callback
+ * @param[in] *count pointer to a captured count buffer
+ * @param[in] len captured count buffer length
+ * @note      it runs in the dma and TIM2 irqs at the same priority, they never nest so
+ *            one static time buffer keeps the 1KB off the irq stack
+ */
+static void a_ic_callback(const uint32_t *count, uint16_t len)
+{
+    /* convert the counts */
+    if (bpc_interface_timestamp_from_count(count, len, gs_ic_time) != 0)
+    {
+        return;
+    }
+    
+    /* run the ic irq */
+    if (g_ic_irq != NULL)
+    {
+        g_ic_irq(gs_ic_time, len);
+    }
+}
+
+/**
+ * @brief     pwm input callback
+ * @param[in] count TIM2 count of the falling edge closing the period
+ * @param[in] width low pulse width in us
+ * @param[in] period period in us
+ * @note      none
+ */
+static void a_pwm_callback(uint32_t count, uint32_t width, uint32_t period)
+{
+    bpc_time_t t;
+    
+    /* convert the count */
+    if (bpc_interface_timestamp_from_count(&count, 1, &t) != 0)
+    {
+        return;
+    }
+    
+    /* run the pwm irq */
+    if (g_pwm_irq != NULL)
+    {
+        g_pwm_irq(&t, width, period);
+    }
+}
+
+/**
+ * @brief     input init
+ * @param[in] input 0 is exti, 1 is input capture, 2 is pwm input
+ * @param[in] *irq pointer to an edge irq function address
+ * @param[in] *batch pointer to an edge batch irq function address
+ * @param[in] *pulse pointer to a pulse irq function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_input_init(uint8_t input, uint8_t (*irq)(void), uint8_t (*batch)(const bpc_time_t *t, size_t n),
+                            uint8_t (*pulse)(const bpc_time_t *t, uint32_t width_us, uint32_t period_us))
+{
+    if (input == 0)
+    {
+        /* gpio init */
+        if (gpio_interrupt_init() != 0)
+        {
+            return 1;
+        }
+        
+        /* set the irq */
+        g_gpio_irq = irq;
+    }
+    else if (input == 1)
+    {
+        /* set the irq */
+        g_ic_irq = batch;
+        
+        /* input capture init */
+        if (ic_init(a_ic_callback) != 0)
+        {
+            g_ic_irq = NULL;
+            
+            return 1;
+        }
+    }
+    else
+    {
+        /* set the irq */
+        g_pwm_irq = pulse;
+        
+        /* pwm input init */
+        if (pwm_init(a_pwm_callback) != 0)
+        {
+            g_pwm_irq = NULL;
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     input deinit
+ * @param[in] input 0 is exti, 1 is input capture, 2 is pwm input
+ * @note      none
+ */
+static void a_input_deinit(uint8_t input)
+{
+    if (input == 0)
+    {
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+    }
+    else if (input == 1)
+    {
+        /* input capture deinit */
+        (void)ic_deinit();
+        g_ic_irq = NULL;
+    }
+    else
+    {
+        /* pwm input deinit */
+        (void)pwm_deinit();
+        g_pwm_irq = NULL;
+    }
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] *data pointer to a bpc_t structure
@@ -159,10 +295,14 @@ uint8_t bpc(uint8_t argc, char **argv)
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
         {"times", required_argument, NULL, 1},
+        {"input", required_argument, NULL, 2},
+        {"interval", required_argument, NULL, 3},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
+    uint8_t input = 0;
+    uint32_t interval = 3600;
     
     /* if no params */
     if (argc == 1)
@@ -242,6 +382,39 @@ uint8_t bpc(uint8_t argc, char **argv)
                 break;
             }
 
+            /* input */
+            case 2 :
+            {
+                /* set the input */
+                if (strcmp("exti", optarg) == 0)
+                {
+                    input = 0;
+                }
+                else if (strcmp("capture", optarg) == 0)
+                {
+                    input = 1;
+                }
+                else if (strcmp("pwm", optarg) == 0)
+                {
+                    input = 2;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* resync interval */
+            case 3 :
+            {
+                /* set the interval */
+                interval = atol(optarg);
+
+                break;
+            }
+
             /* the end */
             case -1 :
             {
@@ -261,27 +434,23 @@ uint8_t bpc(uint8_t argc, char **argv)
     {
         uint8_t res;
         
-        /* gpio init */
-        res = gpio_interrupt_init();
+        /* input init */
+        res = a_input_init(input, bpc_receive_test_irq_handler, bpc_receive_test_irq_handler_batch,
+                           bpc_receive_test_irq_handler_pulse);
         if (res != 0)
         {
             return 1;
         }
         
-        /* set the irq */
-        g_gpio_irq = bpc_receive_test_irq_handler;
-        
         /* run the receive test */
         res = bpc_receive_test(times);
         if (res != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_input_deinit(input);
         }
         
-        /* gpio deinit */
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        /* input deinit */
+        a_input_deinit(input);
         
         return 0;
     }
@@ -291,30 +460,26 @@ uint8_t bpc(uint8_t argc, char **argv)
         uint32_t i;
         uint16_t timeout;
         
-        /* gpio init */
-        res = gpio_interrupt_init();
+        /* input init */
+        res = a_input_init(input, bpc_basic_irq_handler, bpc_basic_irq_handler_batch,
+                           bpc_basic_irq_handler_pulse);
         if (res != 0)
         {
             return 1;
         }
         
-        /* set the irq */
-        g_gpio_irq = bpc_basic_irq_handler;
-        
         /* basic init */
         res = bpc_basic_init(a_receive_callback);
         if (res != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_input_deinit(input);
         }
         
         /* set time zone */
         res = bpc_basic_set_timestamp_time_zone(8);
         if (res != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_input_deinit(input);
         }
         
         /* loop */
@@ -351,8 +516,7 @@ uint8_t bpc(uint8_t argc, char **argv)
                 /* receive timeout */
                 bpc_interface_debug_print("bpc: receive timeout.\n");
                 (void)bpc_basic_deinit();
-                (void)gpio_interrupt_deinit();
-                g_gpio_irq = NULL;
+                a_input_deinit(input);
                 
                 return 1;
             }
@@ -361,9 +525,89 @@ uint8_t bpc(uint8_t argc, char **argv)
         /* basic deinit */
         (void)bpc_basic_deinit();
         
-        /* gpio deinit */
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        /* input deinit */
+        a_input_deinit(input);
+        
+        return 0;
+    }
+    else if (strcmp("e_power", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        bpc_power_config_t power;
+        bpc_power_info_t info;
+        
+        /* the exti input is masked with the receiver */
+        res = a_input_init(0, bpc_basic_irq_handler, bpc_basic_irq_handler_batch,
+                           bpc_basic_irq_handler_pulse);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* power pin init */
+        (void)gpio_power_init();
+        
+        /* one fix per interval, the receiver starts 5s early and tries 3 frames */
+        power.interval_s = interval;
+        power.guard_ms = 5000;
+        power.window_frame = 3;
+        res = bpc_power_init(&power, a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_power_deinit();
+            a_input_deinit(0);
+            
+            return 1;
+        }
+        
+        /* set time zone */
+        res = bpc_basic_set_timestamp_time_zone(8);
+        if (res != 0)
+        {
+            (void)bpc_power_deinit();
+            (void)gpio_power_deinit();
+            a_input_deinit(0);
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* output */
+            bpc_interface_debug_print("%d/%d\n", i + 1, times);
+            
+            /* init 0 */
+            g_flag = 0;
+            
+            /* run the scheduler until a fix */
+            while (g_flag == 0)
+            {
+                res = bpc_power_run();
+                if (res != 0)
+                {
+                    (void)bpc_power_deinit();
+                    (void)gpio_power_deinit();
+                    a_input_deinit(0);
+                    
+                    return 1;
+                }
+            }
+        }
+        
+        /* output the power info */
+        (void)bpc_power_get_info(&info);
+        bpc_interface_debug_print("bpc: %d windows ok, %d windows failed.\n", info.window_ok, info.window_failed);
+        bpc_interface_debug_print("bpc: receiver on %d s and off %d s.\n", 
+                                  (uint32_t)(info.on_ms / 1000), (uint32_t)(info.off_ms / 1000));
+        
+        /* power deinit */
+        (void)bpc_power_deinit();
+        (void)gpio_power_deinit();
+        
+        /* input deinit */
+        a_input_deinit(0);
         
         return 0;
     }
@@ -374,16 +618,21 @@ uint8_t bpc(uint8_t argc, char **argv)
         bpc_interface_debug_print("  bpc (-i | --information)\n");
         bpc_interface_debug_print("  bpc (-h | --help)\n");
         bpc_interface_debug_print("  bpc (-p | --port)\n");
-        bpc_interface_debug_print("  bpc (-t read | --test=read) [--times=<num>]\n");
-        bpc_interface_debug_print("  bpc (-e read | --example=read) [--times=<num>]\n");
+        bpc_interface_debug_print("  bpc (-t read | --test=read) [--times=<num>] [--input=<exti | capture | pwm>]\n");
+        bpc_interface_debug_print("  bpc (-e read | --example=read) [--times=<num>] [--input=<exti | capture | pwm>]\n");
+        bpc_interface_debug_print("  bpc (-e power | --example=power) [--times=<num>] [--interval=<s>]\n");
         bpc_interface_debug_print("\n");
         bpc_interface_debug_print("Options:\n");
-        bpc_interface_debug_print("  -e <read>, --example=<read>    Run the driver example.\n");
-        bpc_interface_debug_print("  -h, --help                     Show the help.\n");
-        bpc_interface_debug_print("  -i, --information              Show the chip information.\n");
-        bpc_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
-        bpc_interface_debug_print("  -t <read>, --test=<read>       Run the driver test.\n");
-        bpc_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
+        bpc_interface_debug_print("  -e <read | power>, --example=<read | power>\n");
+        bpc_interface_debug_print("                                       Run the driver example.\n");
+        bpc_interface_debug_print("  -h, --help                           Show the help.\n");
+        bpc_interface_debug_print("  -i, --information                    Show the chip information.\n");
+        bpc_interface_debug_print("      --input=<exti | capture | pwm>   Set the edge input, exti on PB0, TIM2_CH3 input capture with dma on PB10\n");
+        bpc_interface_debug_print("                                       or TIM5_CH1 pwm input on PA0.([default: exti])\n");
+        bpc_interface_debug_print("      --interval=<s>                   Set the resync interval of the power example.([default: 3600])\n");
+        bpc_interface_debug_print("  -p, --port                           Display the pin connections of the current board.\n");
+        bpc_interface_debug_print("  -t <read>, --test=<read>             Run the driver test.\n");
+        bpc_interface_debug_print("      --times=<num>                    Set the running times, the power example runs until num fixes.([default: 3])\n");
 
         return 0;
     }
@@ -409,6 +658,9 @@ uint8_t bpc(uint8_t argc, char **argv)
     {
         /* print pin connection */
         bpc_interface_debug_print("bpc: INT connected to GPIOB PIN0.\n");
+        bpc_interface_debug_print("bpc: INT capture input connected to GPIOB PIN10.\n");
+        bpc_interface_debug_print("bpc: INT pwm input connected to GPIOA PIN0.\n");
+        bpc_interface_debug_print("bpc: PON connected to GPIOB PIN1.\n");
 
         return 0;
     }
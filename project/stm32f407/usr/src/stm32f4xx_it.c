@@ -36,6 +36,8 @@
 
 #include "stm32f4xx_it.h"
 #include "tim.h"
+#include "ic.h"
+#include "pwm.h"
 #include "uart.h"
 
 /**
@@ -234,5 +236,75 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     {
         /* run the tim irq handler */
         tim_irq_handler();
+        
+        /* hand the captures over at least once per period */
+        ic_irq_handler();
+    }
+}
+
+/**
+ * @brief     tim output compare callback
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if ((htim->Instance == TIM2) && (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_4))
+    {
+        /* hand the captures over when the dma is slow */
+        ic_irq_handler();
+    }
+}
+
+/**
+ * @brief dma1 stream1 irq handler
+ * @note  none
+ */
+void DMA1_Stream1_IRQHandler(void)
+{
+    /* run the dma callback */
+    HAL_DMA_IRQHandler(ic_get_dma_handle());
+}
+
+/**
+ * @brief tim5 irq handler
+ * @note  none
+ */
+void TIM5_IRQHandler(void)
+{
+    /* run the tim callback */
+    HAL_TIM_IRQHandler(pwm_get_handle());
+}
+
+/**
+ * @brief     tim input capture half complete callback
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_IC_CaptureHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* run the ic irq handler */
+        ic_irq_handler();
+    }
+}
+
+/**
+ * @brief     tim input capture callback
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* run the ic irq handler */
+        ic_irq_handler();
+    }
+    if ((htim->Instance == TIM5) && (htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1))
+    {
+        /* run the pwm irq handler */
+        pwm_irq_handler();
     }
 }
@@ -35,7 +35,6 @@
  */
 
 #include "driver_bpc.h"
-#include <stdlib.h>
 
 /**
  * @brief chip information definition
@@ -61,132 +60,219 @@
 #define BPC_CHECK_DATA_3                 (400 * 1000)        /**< data 3 */
 
 /**
- * @brief     check the frame time
- * @param[in] check checked time
- * @param[in] t standard time
- * @return    status code
- *            - 0 success
- *            - 1 checked failed
+ * @brief frame length definition
+ */
+#define BPC_FRAME_INTERVAL_LEN           37                  /**< p1 to p3 and day to year pulse and remain time, p4 pulse time */
+
+/**
+ * @brief vote definition
+ */
+#define BPC_SYMBOL_ERASED                0xFF                /**< erased symbol */
+#define BPC_VOTE_FRAME_TIME              (20 * 1000 * 1000)  /**< time between the frames of one minute */
+#define BPC_VOTE_TOLERANCE               (1000 * 1000)       /**< vote frame time tolerance */
+
+/**
+ * @brief frame fail definition
+ */
+#define BPC_FAIL_NONE                    0                   /**< frame ok */
+#define BPC_FAIL_SYMBOL                  1                   /**< symbol out of the windows */
+#define BPC_FAIL_P1                      2                   /**< p1 is over 2 */
+#define BPC_FAIL_PARITY_FIRST            3                   /**< p3 parity error */
+#define BPC_FAIL_PARITY_SECOND           4                   /**< p4 parity error */
+
+/**
+ * @brief stats definition
+ */
+#define BPC_STATS_READ_RETRY             8                   /**< stats read retry times */
+#if (BPC_STATS != 0)
+    #define BPC_STATS_ADD(handle, count, n)        a_bpc_stats_add((handle), &(handle)->stats.count, (n))        /**< add n to a stats counter */
+#else
+    #define BPC_STATS_ADD(handle, count, n)                                                                       /**< no stats */
+#endif
+
+/**
+ * @brief window unit definition
+ */
+#if (BPC_COMPACT_DELTA != 0)
+    #define BPC_WINDOW_UNIT              1000                /**< windows in ms like the delta ring */
+#else
+    #define BPC_WINDOW_UNIT              1                   /**< windows in us */
+#endif
+
+/**
+ * @brief latest definition
+ */
+#define BPC_LATEST_READ_RETRY            8                   /**< latest read retry times */
+
+/**
+ * @brief rescan definition
+ */
+#define BPC_DECODE_RESCAN_MAX            (BPC_DELTA_BUFFER_SIZE - 1)        /**< max intervals decoded again after one failed frame */
+
+/**
+ * @brief soft decision definition
+ */
+#define BPC_SOFT_FLIP_CONFIDENCE         50                  /**< only a symbol below this confidence in percent is flipped */
+#define BPC_SOFT_FLIP_MARGIN             20                  /**< the flipped symbol is this confidence in percent below the others */
+
+/**
+ * @brief default range definition
+ */
+#define BPC_DEFAULT_START_RANGE          ((uint8_t)(BPC_MAX_START_RANGE * 100.0f + 0.5f))        /**< default start range in percent */
+#define BPC_DEFAULT_RANGE                ((uint8_t)(BPC_MAX_RANGE * 100.0f + 0.5f))              /**< default range in percent */
+
+#if ((BPC_DELTA_BUFFER_SIZE < (BPC_FRAME_INTERVAL_LEN + 1)) || (BPC_DELTA_BUFFER_SIZE > 255))
+    #error "BPC_DELTA_BUFFER_SIZE must hold one frame of intervals, from 38 to 255"
+#endif
+
+#if ((BPC_FIFO_SIZE != 0) && ((BPC_FIFO_SIZE < 2) || (BPC_FIFO_SIZE > 128) || ((BPC_FIFO_SIZE & (BPC_FIFO_SIZE - 1)) != 0)))
+    #error "BPC_FIFO_SIZE must be 0 or a power of 2 from 2 to 128"
+#endif
+
+#if ((BPC_STATS == 0) && (BPC_STATS_TIMING != 0))
+    #error "BPC_STATS_TIMING needs BPC_STATS"
+#endif
+
+/**
+ * @brief      bpc window set
+ * @param[out] *window pointer to a bpc window structure
+ * @param[in]  min min time in us
+ * @param[in]  max max time in us
+ * @note       the window keeps every interval of the delta resolution in [min, max]
+ */
+static void a_bpc_window_set(bpc_window_t *window, uint32_t min, uint32_t max)
+{
+    window->min = (bpc_delta_t)((min + BPC_WINDOW_UNIT - 1) / BPC_WINDOW_UNIT);               /* round min up */
+    window->max = (bpc_delta_t)(max / BPC_WINDOW_UNIT);                                       /* round max down */
+}
+
+/**
+ * @brief     bpc window min
+ * @param[in] *window pointer to a bpc window structure
+ * @return    min time in us
  * @note      none
  */
-static inline uint8_t a_check_frame(uint32_t check, uint32_t t)
+static inline uint32_t a_bpc_window_min(const bpc_window_t *window)
 {
-    if (abs((int)((int)check - (int)t)) > (int)((float)(t) * BPC_MAX_RANGE))        /* check the time */
-    {
-        return 1;                                                                   /* check failed */
-    }
-    else
+    return (uint32_t)window->min * BPC_WINDOW_UNIT;                                           /* convert to us */
+}
+
+/**
+ * @brief     bpc window max
+ * @param[in] *window pointer to a bpc window structure
+ * @return    max time in us
+ * @note      none
+ */
+static inline uint32_t a_bpc_window_max(const bpc_window_t *window)
+{
+    return (uint32_t)window->max * BPC_WINDOW_UNIT;                                           /* convert to us */
+}
+
+/**
+ * @brief     bpc window update
+ * @param[in] *handle pointer to a bpc handle structure
+ * @note      windows are inclusive and computed once, so the decoder only compares integers
+ */
+static void a_bpc_window_update(bpc_handle_t *handle)
+{
+    const uint32_t data[4] = {BPC_CHECK_DATA_0, BPC_CHECK_DATA_1,
+                              BPC_CHECK_DATA_2, BPC_CHECK_DATA_3};
+    uint8_t i;
+    
+    for (i = 0; i < 4; i++)                                                                            /* set all data windows */
     {
-        return 0;                                                                   /* success return 0 */
+        a_bpc_window_set(&handle->data_window[i], 
+                         data[i] - data[i] / 100 * handle->range, 
+                         data[i] + data[i] / 100 * handle->range);                                     /* set data window */
     }
+    a_bpc_window_set(&handle->frame_window, 
+                     BPC_CHECK_FRAME_TIME / 100 * (100 - handle->range), 
+                     BPC_CHECK_FRAME_TIME / 100 * (100 + handle->range));                              /* set frame window */
+    a_bpc_window_set(&handle->start_window, 
+                     BPC_CHECK_START_FRAME_MIN / 100 * (100 - handle->start_range) + 1, 
+                     BPC_CHECK_START_FRAME_MAX / 100 * (100 + handle->start_range));                   /* set start frame window */
 }
 
 /**
- * @brief     check the frame time
+ * @brief     check the time window
+ * @param[in] *window pointer to a bpc window structure
  * @param[in] check checked time
- * @param[in] t standard time
  * @return    status code
  *            - 0 success
  *            - 1 checked failed
  * @note      none
  */
-static inline uint8_t a_check_frame2(uint32_t check, uint32_t remain_check, uint32_t t)
+static inline uint8_t a_check_window(const bpc_window_t *window, uint32_t check)
 {
-    uint32_t total;
-    
-    total = check + remain_check;                                                           /* get the total time */
-    if (((float)(total) < (float)(BPC_CHECK_FRAME_TIME) * (1.0f - BPC_MAX_RANGE)) ||
-        ((float)(total) > (float)(BPC_CHECK_FRAME_TIME) * (1.0f + BPC_MAX_RANGE)))          /* check range */
+    if ((check >= a_bpc_window_min(window)) && 
+        (check <= a_bpc_window_max(window)))                     /* check range */
     {
-        return 1;                                                                           /* check failed */
-    }
-    
-    if (abs((int)((int)check - (int)t)) > (int)((float)(t) * BPC_MAX_RANGE))                /* check the time */
-    {
-        return 1;                                                                           /* check failed */
+        return 0;                                                /* success return 0 */
     }
     else
     {
-        return 0;                                                                           /* success return 0 */
+        return 1;                                                /* check failed */
     }
 }
 
 /**
  * @brief     check the start frame time
+ * @param[in] *handle pointer to a bpc handle structure
  * @param[in] check checked time
- * @param[in] t standard time
  * @return    status code
  *            - 0 success
  *            - 1 checked failed
  * @note      none
  */
-static inline uint8_t a_check_start_frame(uint32_t check)
+static inline uint8_t a_check_start_frame(bpc_handle_t *handle, uint32_t check)
 {
-    if (((float)(check) > (float)(BPC_CHECK_START_FRAME_MIN) * (1.0f - BPC_MAX_START_RANGE)) &&
-        ((float)(check) < (float)(BPC_CHECK_START_FRAME_MAX) * (1.0f + BPC_MAX_START_RANGE)))        /* check range */
-    {
-        return 0;                                                                                    /* success return 0 */ 
-    }
-    else
-    {
-        return 1;                                                                                    /* check failed */
-    }
+    return a_check_window(&handle->start_window, check);        /* check the start window */
 }
 
 /**
- * @brief     bpc trace decode
+ * @brief     bpc delta push
  * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] diff_us diff time in us
  * @note      none
  */
-static void a_bpc_trace_decode(bpc_handle_t *handle)
+static inline void a_bpc_delta_push(bpc_handle_t *handle, uint32_t diff_us)
 {
-    int64_t diff;
+#if (BPC_COMPACT_DELTA != 0)
+    uint32_t ms;
     
-    diff = (int64_t)((int64_t)handle->decode[0].t.s -
-           (int64_t)handle->last_time.s) * 1000000 + 
-           (int64_t)((int64_t)handle->decode[0].t.us -
-           (int64_t)handle->last_time.us);               /* diff time */
-    if (a_check_start_frame((uint32_t)diff) == 0)        /* check diff time */
+    ms = (diff_us + 500) / 1000;                                                  /* convert to ms */
+    handle->delta[handle->delta_head] = (ms > 0xFFFFU) ? 0xFFFFU : (uint16_t)ms;  /* save the interval */
+#else
+    handle->delta[handle->delta_head] = diff_us;                                  /* save the interval */
+#endif
+    handle->delta_head++;                                                         /* head++ */
+    if (handle->delta_head >= BPC_DELTA_BUFFER_SIZE)                              /* check the end */
     {
-        handle->decode_offset = 0;                       /* init 0 */
-        handle->decode_valid = 1;                        /* set valid */
-        handle->trace_valid = 0;                         /* set invalid */
-    }
-    else
-    {
-        handle->decode_len = 0;                          /* clear the buffer */
-        handle->decode_offset = 0;                       /* init 0 */
-        handle->decode_valid = 0;                        /* set invalid */
-        handle->trace_valid = 0;                         /* set invalid */
+        handle->delta_head = 0;                                                   /* wrap around */
     }
 }
 
 /**
- * @brief     bpc start decode
+ * @brief     bpc delta get
  * @param[in] *handle pointer to a bpc handle structure
- * @note      none
+ * @param[in] back interval count back from the newest one
+ * @return    diff time in us
+ * @note      back must be less than BPC_DELTA_BUFFER_SIZE
  */
-static void a_bpc_start_decode(bpc_handle_t *handle)
+static inline uint32_t a_bpc_delta_get(bpc_handle_t *handle, uint8_t back)
 {
-    uint16_t i;
-    uint16_t len;
+    uint16_t ind;
     
-    len = handle->decode_len - 1;                                                 /* len - 1 */
-    for (i = 0; i < len; i++)                                                     /* diff all time */
+    ind = (uint16_t)handle->delta_head + BPC_DELTA_BUFFER_SIZE - 1 - back;       /* get the index */
+    if (ind >= BPC_DELTA_BUFFER_SIZE)                                             /* check the end */
     {
-        int64_t diff;
-        
-        diff = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-               (int64_t)handle->decode[i].t.s) * 1000000 + 
-               (int64_t)((int64_t)handle->decode[i + 1].t.us -
-               (int64_t)handle->decode[i].t.us);                                  /* diff time */
-        handle->decode[i].diff_us = (uint32_t)diff;                               /* save the time diff */
-        if (a_check_start_frame((uint32_t)handle->decode[i].diff_us) == 0)        /* check start frame */
-        {
-            handle->decode_valid = 1;                                             /* set valid */
-            handle->decode_offset = (uint8_t)(i + 1);                             /* save offset */
-        }
+        ind -= BPC_DELTA_BUFFER_SIZE;                                             /* wrap around */
     }
+#if (BPC_COMPACT_DELTA != 0)
+    return (uint32_t)handle->delta[ind] * 1000;                                   /* convert to us */
+#else
+    return handle->delta[ind];                                                    /* return the interval */
+#endif
 }
 
 /**
@@ -198,37 +284,116 @@ static void a_bpc_start_decode(bpc_handle_t *handle)
  */
 static uint8_t a_bpc_data_decode(bpc_handle_t *handle, uint32_t diff_us, uint8_t *data)
 {
-    if (a_check_frame(diff_us, BPC_CHECK_DATA_0) == 0)                    /* check diff */
+    uint8_t i;
+    
+    for (i = 0; i < 4; i++)                                                  /* check data 0 - 3 */
     {
-        *data = 0;                                                        /* set data 0 */
+        if (a_check_window(&handle->data_window[i], diff_us) == 0)          /* check diff */
+        {
+            *data = i;                                                       /* set data */
+            
+            return 0;                                                        /* success return 0 */
+        }
     }
-    else
+    
+    return 1;                                                                /* return error */
+}
+
+/**
+ * @brief     bpc symbol confidence
+ * @param[in] diff_us pulse time in us
+ * @param[in] symbol decoded symbol
+ * @return    confidence in percent
+ * @note      100 is the nominal pulse time, 0 is the middle to the nearest other symbol
+ */
+static uint8_t a_bpc_symbol_confidence(uint32_t diff_us, uint8_t symbol)
+{
+    uint32_t nominal;
+    uint32_t d;
+    uint32_t d2;
+    
+    nominal = (uint32_t)(symbol + 1) * BPC_CHECK_DATA_0;                                    /* get the nominal time */
+    if (diff_us < nominal)                                                                   /* shorter than nominal */
     {
-        if (a_check_frame(diff_us, BPC_CHECK_DATA_1) == 0)                /* check start diff */
+        if (symbol == 0)                                                                     /* no shorter symbol */
         {
-            *data = 1;                                                    /* set data 1 */
+            return 100;                                                                      /* return 100 */
         }
-        else
+        d = nominal - diff_us;                                                               /* distance to this symbol */
+        d2 = (diff_us > nominal - BPC_CHECK_DATA_0) ? 
+             (diff_us - (nominal - BPC_CHECK_DATA_0)) : 0;                                   /* distance to the shorter symbol */
+    }
+    else
+    {
+        if (symbol == 3)                                                                     /* no longer symbol */
         {
-            if (a_check_frame(diff_us, BPC_CHECK_DATA_2) == 0)            /* check start diff */
-            {
-                *data = 2;                                                /* set data 2 */
-            }
-            else
-            {
-                if (a_check_frame(diff_us, BPC_CHECK_DATA_3) == 0)        /* check start diff */
-                {
-                    *data = 3;                                            /* set data 3 */
-                }
-                else
-                {
-                    return 1;                                             /* return error */
-                }
-            }
+            return 100;                                                                      /* return 100 */
         }
+        d = diff_us - nominal;                                                               /* distance to this symbol */
+        d2 = (diff_us < nominal + BPC_CHECK_DATA_0) ? 
+             (nominal + BPC_CHECK_DATA_0 - diff_us) : 0;                                     /* distance to the longer symbol */
     }
+    if (d >= d2)                                                                             /* the other symbol is nearer */
+    {
+        return 0;                                                                            /* return 0 */
+    }
+    
+    return (uint8_t)((d2 - d) * 100 / d2);                                                   /* get the confidence */
+}
+
+/**
+ * @brief     bpc soft data decode
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] diff_us diff time in us
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 decode failed
+ * @note      the nearest nominal pulse time wins, overlaps and gaps of the windows are resolved
+ */
+static uint8_t a_bpc_soft_decode(bpc_handle_t *handle, uint32_t diff_us, uint8_t *data)
+{
+    uint32_t symbol;
+    
+    if ((diff_us < a_bpc_window_min(&handle->data_window[0])) || 
+        (diff_us > a_bpc_window_max(&handle->data_window[3])))                               /* check the range */
+    {
+        return 1;                                                                            /* return error */
+    }
+    symbol = (diff_us + BPC_CHECK_DATA_0 / 2) / BPC_CHECK_DATA_0;                            /* get the nearest symbol + 1 */
+    if (symbol > 4)                                                                          /* longer than data 3 */
+    {
+        symbol = 4;                                                                          /* set data 3 */
+    }
+    if (symbol < 1)                                                                          /* shorter than data 0 */
+    {
+        symbol = 1;                                                                          /* set data 0 */
+    }
+    *data = (uint8_t)(symbol - 1);                                                           /* set data */
     
-    return 0;                                                             /* success return 0 */
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     bpc symbol decode
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] diff_us pulse time in us
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 decode failed
+ * @note      none
+ */
+static uint8_t a_bpc_symbol_decode(bpc_handle_t *handle, uint32_t diff_us, uint8_t *data)
+{
+    if (handle->soft != 0)                                                                   /* soft decision */
+    {
+        return a_bpc_soft_decode(handle, diff_us, data);                                     /* get data */
+    }
+    else
+    {
+        return a_bpc_data_decode(handle, diff_us, data);                                     /* get data */
+    }
 }
 
 /**
@@ -237,895 +402,1159 @@ static uint8_t a_bpc_data_decode(bpc_handle_t *handle, uint32_t diff_us, uint8_t
  * @param[in] diff_us diff time in us
  * @param[in] remain_diff_us remain diff time in us
  * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame time is invalid
+ *            - 2 pulse time is invalid
  * @note      none
  */
 static uint8_t a_bpc_data_decode2(bpc_handle_t *handle, uint32_t diff_us, uint32_t remain_diff_us, uint8_t *data)
 {
-    if (a_check_frame2(diff_us, remain_diff_us, BPC_CHECK_DATA_0) == 0)                    /* check diff */
+    if (a_check_window(&handle->frame_window, diff_us + remain_diff_us) != 0)        /* check the total time */
     {
-        *data = 0;                                                                         /* set data 0 */
+        return 1;                                                                    /* return error */
     }
-    else
+    if (a_bpc_symbol_decode(handle, diff_us, data) != 0)                             /* decode the pulse time */
     {
-        if (a_check_frame2(diff_us, remain_diff_us, BPC_CHECK_DATA_1) == 0)                /* check start diff */
-        {
-            *data = 1;                                                                     /* set data 1 */
-        }
-        else
-        {
-            if (a_check_frame2(diff_us, remain_diff_us, BPC_CHECK_DATA_2) == 0)            /* check start diff */
-            {
-                *data = 2;                                                                 /* set data 2 */
-            }
-            else
-            {
-                if (a_check_frame2(diff_us, remain_diff_us, BPC_CHECK_DATA_3) == 0)        /* check start diff */
-                {
-                    *data = 3;                                                             /* set data 3 */
-                }
-                else
-                {
-                    return 1;                                                              /* return error */
-                }
-            }
-        }
+        return 2;                                                                    /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     bpc decode
+ * @brief     bpc decode clear
  * @param[in] *handle pointer to a bpc handle structure
  * @note      none
  */
-static void a_bpc_decode(bpc_handle_t *handle)
+static void a_bpc_decode_clear(bpc_handle_t *handle)
 {
-    if (handle->decode_len - handle->decode_offset >= 38)                                       /* if the min length */
-    {
-        uint8_t res;
-        uint8_t p1;
-        uint8_t p2;
-        uint8_t p3;
-        uint8_t p4;
-        uint8_t temp0;
-        uint8_t temp1;
-        uint8_t temp2;
-        uint8_t count;
-        uint16_t i;
-        uint16_t len;
-        uint16_t ind;
-        uint16_t parity;
-        bpc_t data = {0};
-        
-        len = handle->decode_len - 1;                                                           /* len - 1 */
-        for (i = 0; i < len; i++)                                                               /* diff all time */
-        {
-            int64_t diff;
-            
-            diff = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-                   (int64_t)handle->decode[i].t.s) * 1000000 + 
-                   (int64_t)((int64_t)handle->decode[i + 1].t.us -
-                   (int64_t)handle->decode[i].t.us);                                            /* diff time */
-            handle->decode[i].diff_us = (uint32_t)diff;                                         /* save the time diff */
-        }
-        
-        ind = handle->decode_offset;                                                            /* set start index */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &p1);                /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        if (p1 == 0)                                                                            /* 19 second */
-        {
-            data.second = 19;                                                                   /* set 19s */
-        }
-        else if (p1 == 1)                                                                       /* 39 second */
-        {
-            data.second = 39;                                                                   /* set 39s */
-        }
-        else if (p1 == 2)                                                                       /* 59 second */
-        {
-            data.second = 59;                                                                   /* set 59s */
-        }
-        else                                                                                    /* invalid */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &p2);                /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        data.hour = (temp0 << 2) | temp1;                                                       /* set hour */
+    handle->decode_valid = 0;                                /* set invalid */
+    handle->decode_index = 0;                                /* init 0 */
+    handle->decode_parity = 0;                               /* init 0 */
+    handle->decode_joined = 0;                               /* not joined */
+}
+
+#if (BPC_LATEST != 0)
+/**
+ * @brief     bpc latest publish
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *data pointer to a bpc structure
+ * @note      the frame is written into the slot not published and then the slot is published
+ */
+static void a_bpc_latest_publish(bpc_handle_t *handle, const bpc_t *data)
+{
+    uint8_t next;
+    bpc_latest_t *slot;
+    const bpc_latest_t *last;
+    
+    next = (uint8_t)(handle->latest_index ^ 1);                      /* get the other slot */
+    slot = &handle->latest[next];                                    /* get the slot */
+    last = &handle->latest[handle->latest_index];                    /* get the published slot */
+    handle->latest_seq[next]++;                                      /* seq++ */
+    BPC_MEMORY_BARRIER();                                            /* seq before the slot */
+    if (data->status == BPC_STATUS_OK)                               /* ok frame */
+    {
+        slot->data = *data;                                          /* copy the frame */
+        slot->ref_time = handle->ref_time;                           /* copy the reference edge time */
+    }
+    else
+    {
+        slot->data = last->data;                                     /* keep the last ok frame */
+        slot->ref_time = last->ref_time;                             /* keep the last reference edge time */
+    }
+    slot->status = data->status;                                     /* set the status */
+    BPC_MEMORY_BARRIER();                                            /* slot before the seq */
+    handle->latest_seq[next]++;                                      /* seq++ */
+    BPC_MEMORY_BARRIER();                                            /* seq before the index */
+    handle->latest_index = next;                                     /* publish the slot */
+    BPC_MEMORY_BARRIER();                                            /* index before the valid */
+    handle->latest_valid = 1;                                        /* set valid */
+}
+#endif
+
+#if (BPC_STATS != 0)
+/**
+ * @brief     bpc stats update begin
+ * @param[in] *handle pointer to a bpc handle structure
+ * @note      the sequence is odd while the stats are updated
+ */
+static inline void a_bpc_stats_begin(bpc_handle_t *handle)
+{
+    handle->stats_seq++;                                             /* seq++ */
+    BPC_MEMORY_BARRIER();                                            /* seq before the stats */
+}
+
+/**
+ * @brief     bpc stats update end
+ * @param[in] *handle pointer to a bpc handle structure
+ * @note      none
+ */
+static inline void a_bpc_stats_end(bpc_handle_t *handle)
+{
+    BPC_MEMORY_BARRIER();                                            /* stats before the seq */
+    handle->stats_seq++;                                             /* seq++ */
+}
+
+/**
+ * @brief     bpc stats counter add
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *count pointer to a stats counter
+ * @param[in] n added value
+ * @note      only the counter update is in the sequence, never a callback
+ */
+static inline void a_bpc_stats_add(bpc_handle_t *handle, uint32_t *count, uint32_t n)
+{
+    a_bpc_stats_begin(handle);                                       /* begin the stats update */
+    *count += n;                                                     /* count += n */
+    a_bpc_stats_end(handle);                                         /* end the stats update */
+}
+#endif
+
+/**
+ * @brief     bpc decode failed
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] fail fail reason
+ * @note      a start frame joined across a glitch is only a guess, its failure is silent
+ */
+static void a_bpc_decode_failed(bpc_handle_t *handle, uint8_t fail)
+{
+    bpc_t data;
+    
+    if (handle->decode_joined != 0)                                                          /* joined start frame */
+    {
+        a_bpc_decode_clear(handle);                                                          /* clear the frame */
         
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp2);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        return;                                                                              /* return */
+    }
+    switch (fail)                                                                            /* check the reason */
+    {
+        case BPC_FAIL_P1 :
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
+            BPC_STATS_ADD(handle, p1_invalid, 1);                                            /* p1 invalid++ */
+            data.status = BPC_STATUS_FRAME_INVALID;                                          /* set frame invalid */
             
-            return;                                                                             /* return */
+            break;                                                                           /* break */
         }
-        ind += 2;                                                                               /* index + 2 */
-        data.minute = ((uint8_t)temp0 << 4) | ((uint8_t)temp1 << 2) | temp2;                    /* set minute */
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        case BPC_FAIL_PARITY_FIRST :
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
+            BPC_STATS_ADD(handle, parity_first, 1);                                          /* parity first++ */
+            data.status = BPC_STATUS_PARITY_ERR;                                             /* set parity error */
             
-            return;                                                                             /* return */
+            break;                                                                           /* break */
         }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        case BPC_FAIL_PARITY_SECOND :
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
+            BPC_STATS_ADD(handle, parity_second, 1);                                         /* parity second++ */
+            data.status = BPC_STATUS_PARITY_ERR;                                             /* set parity error */
             
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
+            break;                                                                           /* break */
         }
-        ind += 2;                                                                               /* index + 2 */
-        data.week = (temp0 << 2) | temp1;                                                       /* set week */
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &p3);                /* get data */
-        if (res != 0)                                                                           /* check the result */
+        default :
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
+            BPC_STATS_ADD(handle, symbol_invalid, 1);                                        /* symbol invalid++ */
+            data.status = BPC_STATUS_FRAME_INVALID;                                          /* set frame invalid */
             
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        
-        count = 0;                                                                              /* init 0 */
-        parity = p1;                                                                            /* set p1 */
-        while (parity != 0)                                                                     /* check 0 */
-        {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            break;                                                                           /* break */
         }
-        parity = p2;                                                                            /* set p2 */
-        while (parity != 0)                                                                     /* check 0 */
-        {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
-        }
-        parity = data.hour;                                                                     /* set hour */
-        while (parity != 0)                                                                     /* check 0 */
+    }
+    data.year = 0;                                                                           /* set 0 */
+    data.month = 0;                                                                          /* set 0 */
+    data.day = 0;                                                                            /* set 0 */
+    data.week = 0;                                                                           /* set 0 */
+    data.hour = 0;                                                                           /* set 0 */
+    data.minute = 0;                                                                         /* set 0 */
+    data.second = 0;                                                                         /* set 0 */
+    data.confidence = 0;                                                                     /* set 0 */
+    data.repair = BPC_REPAIR_NONE;                                                           /* set none */
+#if (BPC_LATEST != 0)
+    a_bpc_latest_publish(handle, &data);                                                     /* publish the frame */
+#endif
+    if (handle->receive_callback != NULL)                                                    /* not null */
+    {
+        handle->receive_callback(&data);                                                     /* run the callback */
+    }
+    
+    a_bpc_decode_clear(handle);                                                              /* clear the frame */
+}
+
+/**
+ * @brief     bpc decode reset
+ * @param[in] *handle pointer to a bpc handle structure
+ * @note      none
+ */
+static void a_bpc_decode_reset(bpc_handle_t *handle)
+{
+    a_bpc_decode_clear(handle);                                      /* clear the frame */
+#if (BPC_VOTE != 0)
+    handle->vote_mask = 0;                                           /* clear the vote frames */
+#endif
+    a_bpc_delta_push(handle, 0xFFFFFFFFU);                           /* no interval joins across the reset */
+}
+
+#if (BPC_LATEST != 0)
+/**
+ * @brief      bpc time back
+ * @param[in]  *t pointer to an edge timestamp structure
+ * @param[in]  us time back in us
+ * @param[out] *out pointer to an edge timestamp buffer
+ * @note       out is us before t
+ */
+static void a_bpc_time_back(const bpc_time_t *t, uint32_t us, bpc_time_t *out)
+{
+    uint32_t s;
+    
+    s = us / 1000000;                                                /* get the s part */
+    us -= s * 1000000;                                               /* get the us part */
+    out->s = t->s - s;                                               /* s back */
+    out->us = t->us;                                                 /* copy us */
+    if (out->us < us)                                                /* borrow */
+    {
+        out->s--;                                                    /* s-- */
+        out->us += 1000000;                                          /* us += 1s */
+    }
+    out->us -= us;                                                   /* us back */
+}
+#endif
+
+/**
+ * @brief     bpc decode finished
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *s pointer to a frame symbol buffer
+ * @param[in] confidence frame confidence in percent
+ * @param[in] repair frame repair
+ * @note      none
+ */
+static void a_bpc_decode_finished(bpc_handle_t *handle, const uint8_t *s, uint8_t confidence, uint8_t repair)
+{
+    bpc_t data;
+#if (BPC_LATEST != 0)
+    uint8_t back;
+    uint32_t us;
+    
+    us = 0;                                                                                  /* init 0 */
+    for (back = 0; back <= handle->decode_back; back++)                                      /* the intervals up to the p4 start */
+    {
+        us += a_bpc_delta_get(handle, back);                                                 /* add the interval */
+    }
+    a_bpc_time_back(&handle->edge_time, us, &handle->ref_time);                              /* get the reference edge time */
+    handle->ref_valid = 1;                                                                   /* set valid */
+#endif
+    
+    BPC_STATS_ADD(handle, frame_ok, 1);                                                      /* ok++ */
+    data.status = BPC_STATUS_OK;                                                             /* set ok */
+    data.confidence = confidence;                                                            /* set the confidence */
+    data.repair = repair;                                                                    /* set the repair */
+    data.second = (uint8_t)(19 + s[0] * 20);                                                 /* set 19s, 39s or 59s */
+    data.hour = (uint8_t)((s[2] << 2) | s[3]);                                               /* set hour */
+    data.minute = (uint8_t)((s[4] << 4) | (s[5] << 2) | s[6]);                               /* set minute */
+    data.week = (uint8_t)((s[7] << 2) | s[8]);                                               /* set week */
+    if (s[9] >= 2)                                                                           /* pm */
+    {
+        data.hour += 12;                                                                     /* add 12h */
+    }
+    data.day = (uint8_t)((s[10] << 4) | (s[11] << 2) | s[12]);                               /* set day */
+    data.month = (uint8_t)((s[13] << 2) | s[14]);                                            /* set month */
+    data.year = (uint16_t)((s[15] << 4) | (s[16] << 2) | s[17]);                             /* set year */
+    if (s[18] >= 2)                                                                          /* year add */
+    {
+        data.year += ((uint16_t)1 << 6);                                                     /* add year */
+    }
+    data.year += 2000;                                                                       /* add 2000 */
+    if (data.week == 7)                                                                      /* sunday is 7 in old version */
+    {
+        data.week = 0;                                                                       /* set 0 */
+    }
+#if (BPC_LATEST != 0)
+    a_bpc_latest_publish(handle, &data);                                                     /* publish the frame */
+#endif
+    if (handle->receive_callback != NULL)                                                    /* not null */
+    {
+        handle->receive_callback(&data);                                                     /* run the callback */
+    }
+    
+    a_bpc_decode_clear(handle);                                                              /* clear the frame */
+}
+
+/**
+ * @brief     bpc symbol parity
+ * @param[in] symbol frame symbol
+ * @return    parity of the two symbol bits
+ * @note      none
+ */
+static inline uint8_t a_bpc_symbol_parity(uint8_t symbol)
+{
+    return (uint8_t)((symbol ^ (symbol >> 1)) & 0x1);                /* xor the two bits */
+}
+
+/**
+ * @brief     bpc half check
+ * @param[in] *s pointer to a frame symbol buffer
+ * @param[in] start first symbol index
+ * @param[in] end parity symbol index
+ * @return    status code
+ *            - 0 success
+ *            - 1 parity error
+ * @note      none
+ */
+static uint8_t a_bpc_half_check(const uint8_t *s, uint8_t start, uint8_t end)
+{
+    uint8_t i;
+    uint8_t parity;
+    
+    parity = 0;                                                      /* init 0 */
+    for (i = start; i < end; i++)                                    /* all data symbols */
+    {
+        parity ^= a_bpc_symbol_parity(s[i]);                         /* update the parity */
+    }
+    
+    return (uint8_t)((parity ^ s[end]) & 0x1);                       /* check the parity symbol */
+}
+
+/**
+ * @brief     bpc frame check
+ * @param[in] *s pointer to a frame symbol buffer
+ * @return    frame fail reason
+ * @note      none
+ */
+static uint8_t a_bpc_frame_check(const uint8_t *s)
+{
+    uint8_t i;
+    
+    for (i = 0; i < BPC_FRAME_SYMBOL_LEN; i++)                       /* check all symbols */
+    {
+        if (s[i] > 3)                                                /* check erased */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            return BPC_FAIL_SYMBOL;                                  /* symbol invalid */
         }
-        parity = data.minute;                                                                   /* set minute */
-        while (parity != 0)                                                                     /* check 0 */
+    }
+    if (s[0] > 2)                                                    /* p1 must be 19s, 39s or 59s */
+    {
+        return BPC_FAIL_P1;                                          /* p1 invalid */
+    }
+    if (a_bpc_half_check(s, 0, 9) != 0)                              /* check p1, p2, hour, minute and week parity */
+    {
+        return BPC_FAIL_PARITY_FIRST;                                /* parity error */
+    }
+    if (a_bpc_half_check(s, 10, 18) != 0)                            /* check day, month and year parity */
+    {
+        return BPC_FAIL_PARITY_SECOND;                               /* parity error */
+    }
+    
+    return BPC_FAIL_NONE;                                            /* ok */
+}
+
+/**
+ * @brief     bpc pulse get
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] i symbol index
+ * @return    pulse time in us
+ * @note      the frame intervals up to p4 must be in the delta ring
+ */
+static inline uint32_t a_bpc_pulse_get(bpc_handle_t *handle, uint8_t i)
+{
+    return a_bpc_delta_get(handle, (uint8_t)(handle->decode_back + BPC_FRAME_INTERVAL_LEN - 1 - 2 * i));  /* get the pulse time */
+}
+
+/**
+ * @brief     bpc frame confidence
+ * @param[in] *handle pointer to a bpc handle structure
+ * @return    the lowest symbol confidence in percent
+ * @note      the confidence of every symbol comes from its pulse in the delta ring
+ */
+static uint8_t a_bpc_frame_confidence(bpc_handle_t *handle)
+{
+    uint8_t i;
+    uint8_t c;
+    uint8_t confidence;
+    const uint8_t *s;
+    
+    s = handle->decode_symbol;                                                        /* get the symbols */
+    confidence = 100;                                                                 /* init 100 */
+    for (i = 0; i < BPC_FRAME_SYMBOL_LEN; i++)                                        /* all symbols */
+    {
+        c = (s[i] > 3) ? 0 : a_bpc_symbol_confidence(a_bpc_pulse_get(handle, i), s[i]);  /* an erased symbol has no confidence */
+        if (c < confidence)                                                           /* check the confidence */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            confidence = c;                                                           /* save the lowest */
         }
-        parity = data.week;                                                                     /* set week */
-        while (parity != 0)                                                                     /* check 0 */
+    }
+    
+    return confidence;                                                                /* return the confidence */
+}
+
+/**
+ * @brief     bpc soft repair
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *s pointer to a frame symbol buffer
+ * @return    frame fail reason
+ * @note      a half with a parity error flips its least confident symbol to the
+ *            nearest other symbol when no other symbol of the half is nearly as weak,
+ *            the frame intervals must be in the delta ring
+ */
+static uint8_t a_bpc_soft_repair(bpc_handle_t *handle, uint8_t *s)
+{
+    const uint8_t start[2] = {0, 10};
+    const uint8_t end[2] = {9, 18};
+    uint8_t h;
+    uint8_t i;
+    uint8_t alt;
+    uint8_t best;
+    uint8_t best_alt;
+    uint8_t change;
+    uint8_t confidence;
+    uint8_t best_confidence;
+    uint8_t next_confidence;
+    uint32_t pulse_us;
+    
+    for (h = 0; h < 2; h++)                                                                  /* two parity halves */
+    {
+        if (a_bpc_half_check(s, start[h], end[h]) == 0)                                      /* check the parity */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            continue;                                                                        /* continue */
         }
-        
-        if (p3 == 0)                                                                            /* even, am */
+        best = BPC_SYMBOL_ERASED;                                                            /* init erased */
+        best_alt = 0;                                                                        /* init 0 */
+        best_confidence = 100;                                                               /* init 100 */
+        next_confidence = 100;                                                               /* init 100 */
+        for (i = start[h]; i <= end[h]; i++)                                                 /* all symbols of the half */
         {
-            if ((count % 2) != 0)                                                               /* check even */
+            pulse_us = a_bpc_pulse_get(handle, i);                                           /* get the pulse time */
+            if (pulse_us < (uint32_t)(s[i] + 1) * BPC_CHECK_DATA_0)                         /* shorter than nominal */
             {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
+                alt = (uint8_t)(s[i] - 1);                                                   /* the shorter symbol */
             }
-        }
-        else if (p3 == 1)                                                                       /* odd, am */
-        {
-            if ((count % 2) == 0)                                                               /* check even */
+            else
             {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
+                alt = (uint8_t)(s[i] + 1);                                                   /* the longer symbol */
             }
-        }
-        else if (p3 == 2)                                                                       /* even, pm */
-        {
-            if ((count % 2) != 0)                                                               /* check even */
+            if ((alt > 3) || ((i == 0) && (alt > 2)))                                        /* no other symbol */
             {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
+                continue;                                                                    /* continue */
             }
-            data.hour += 12;                                                                    /* add 12h */
-        }
-        else                                                                                    /* odd, pm */
-        {
-            if ((count % 2) == 0)                                                               /* check even */
+            if (i == end[h])                                                                 /* p3 or p4 */
             {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
+                change = (uint8_t)((s[i] ^ alt) & 0x1);                                      /* the parity bit changes */
             }
-            data.hour += 12;                                                                    /* add 12h */
-        }
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            else
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                change = (uint8_t)(a_bpc_symbol_parity(s[i]) ^ a_bpc_symbol_parity(alt));    /* the symbol parity changes */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            if (change == 0)                                                                 /* the parity stays */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                continue;                                                                    /* continue */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp2);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            confidence = a_bpc_symbol_confidence(pulse_us, s[i]);                            /* get the confidence */
+            if (confidence < best_confidence)                                                /* less confident */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                next_confidence = best_confidence;                                           /* save the runner-up */
+                best = i;                                                                    /* save the index */
+                best_alt = alt;                                                              /* save the symbol */
+                best_confidence = confidence;                                                /* save the confidence */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
-        }
-        ind += 2;                                                                               /* index + 2 */
-        data.day = ((uint8_t)temp0 << 4) | ((uint8_t)temp1 << 2) | temp2;                       /* set day */
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
-        {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            else if (confidence < next_confidence)                                           /* the runner-up */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                next_confidence = confidence;                                                /* save the confidence */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
         }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        if ((best == BPC_SYMBOL_ERASED) || (best_confidence >= BPC_SOFT_FLIP_CONFIDENCE) || 
+            (next_confidence - best_confidence < BPC_SOFT_FLIP_MARGIN))                      /* nothing or no clear symbol to flip */
+        {
+            return (h == 0) ? BPC_FAIL_PARITY_FIRST : BPC_FAIL_PARITY_SECOND;                /* parity error */
+        }
+        s[best] = best_alt;                                                                  /* flip the symbol, its pulse is nearer the old one so its confidence is 0 */
+    }
+    
+    return a_bpc_frame_check(s);                                                             /* check the frame */
+}
+
+#if (BPC_VOTE != 0)
+/**
+ * @brief     bpc vote push
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *s pointer to a frame symbol buffer
+ * @return    frame position in the minute, BPC_SYMBOL_ERASED means unknown
+ * @note      the frames of one minute end 20s apart, a frame out of that
+ *            time line starts a new minute
+ */
+static uint8_t a_bpc_vote_push(bpc_handle_t *handle, const uint8_t *s)
+{
+    uint8_t i;
+    uint8_t pos;
+    uint32_t elapsed;
+    uint32_t expected;
+    
+    pos = s[0];                                                                          /* get p1 */
+    if (pos > 2)                                                                         /* p1 is erased */
+    {
+        for (i = BPC_VOTE_FRAME_LEN; i > 0; i--)                                         /* find the newest frame */
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            if ((handle->vote_mask & (1 << (i - 1))) != 0)                               /* check the frame */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                break;                                                                   /* break */
             }
+        }
+        if (i == 0)                                                                      /* no frame */
+        {
+            return BPC_SYMBOL_ERASED;                                                    /* unknown */
+        }
+        elapsed = handle->vote_clock - handle->vote_time[i - 1];                         /* get the elapsed time */
+        pos = (uint8_t)(i - 1 + (elapsed + BPC_VOTE_FRAME_TIME / 2) / BPC_VOTE_FRAME_TIME);  /* guess p1 from the time */
+        if ((pos < i) || (pos > 2))                                                      /* check the range */
+        {
+            return BPC_SYMBOL_ERASED;                                                    /* unknown */
+        }
+    }
+    for (i = 0; i < BPC_VOTE_FRAME_LEN; i++)                                             /* check the saved frames */
+    {
+        if ((handle->vote_mask & (1 << i)) == 0)                                         /* skip the empty frame */
+        {
+            continue;                                                                    /* continue */
+        }
+        elapsed = handle->vote_clock - handle->vote_time[i];                             /* get the elapsed time */
+        expected = (uint32_t)(pos - i) * BPC_VOTE_FRAME_TIME;                            /* get the expected time */
+        if ((pos <= i) || 
+            (elapsed + BPC_VOTE_TOLERANCE < expected) || 
+            (elapsed > expected + BPC_VOTE_TOLERANCE))                                   /* not in this minute */
+        {
+            handle->vote_mask = 0;                                                       /* start a new minute */
             
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
+            break;                                                                       /* break */
         }
-        ind += 2;                                                                               /* index + 2 */
-        data.month = (temp0 << 2) | temp1;                                                      /* set month */
-        
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp0);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+    }
+    memcpy(handle->vote_symbol[pos], s, BPC_FRAME_SYMBOL_LEN);                           /* save the symbols */
+    handle->vote_symbol[pos][0] = pos;                                                   /* save p1 */
+    if (s[9] <= 3)                                                                       /* p3 is valid */
+    {
+        handle->vote_symbol[pos][9] = (uint8_t)(s[9] ^ a_bpc_symbol_parity(pos));        /* remove the p1 parity */
+    }
+    handle->vote_time[pos] = handle->vote_clock;                                         /* save the time */
+    handle->vote_mask |= (uint8_t)(1 << pos);                                            /* set the frame valid */
+    
+    return pos;                                                                          /* return the position */
+}
+
+/**
+ * @brief      bpc vote merge
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[in]  pos frame position in the minute
+ * @param[out] *s pointer to a frame symbol buffer
+ * @return     frame fail reason
+ * @note       a symbol is the value most frames agree on, a tie is erased
+ */
+static uint8_t a_bpc_vote_merge(bpc_handle_t *handle, uint8_t pos, uint8_t *s)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t v;
+    uint8_t best;
+    uint8_t count[4];
+    
+    for (i = 1; i < BPC_FRAME_SYMBOL_LEN; i++)                                           /* p2 to p4 */
+    {
+        memset(count, 0, sizeof(count));                                                 /* clear the count */
+        for (j = 0; j < BPC_VOTE_FRAME_LEN; j++)                                         /* all frames */
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            v = handle->vote_symbol[j][i];                                               /* get the symbol */
+            if (((handle->vote_mask & (1 << j)) != 0) && (v <= 3))                      /* check the symbol */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                count[v]++;                                                              /* count++ */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
         }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp1);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        best = 0;                                                                        /* init 0 */
+        for (v = 1; v < 4; v++)                                                          /* find the max count */
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            if (count[v] > count[best])                                                  /* check the count */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                best = v;                                                                /* set the best */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
         }
-        ind += 2;                                                                               /* index + 2 */
-        res = a_bpc_data_decode2(handle, (uint32_t)handle->decode[ind].diff_us,
-                                (uint32_t)handle->decode[ind + 1].diff_us, &temp2);             /* get data */
-        if (res != 0)                                                                           /* check the result */
+        s[i] = best;                                                                     /* set the symbol */
+        for (v = 0; v < 4; v++)                                                          /* check the tie */
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
+            if ((v != best) && (count[v] == count[best]))                                /* no majority */
             {
-                handle->receive_callback(&data);                                                /* run the callback */
+                s[i] = BPC_SYMBOL_ERASED;                                                /* erase the symbol */
             }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
         }
-        ind += 2;                                                                               /* index + 2 */
-        data.year = ((uint8_t)temp0 << 4) | ((uint8_t)temp1 << 2) | temp2;                      /* set year */
+    }
+    s[0] = pos;                                                                          /* set p1 */
+    if (s[9] <= 3)                                                                       /* p3 is valid */
+    {
+        s[9] = (uint8_t)(s[9] ^ a_bpc_symbol_parity(pos));                               /* add the p1 parity */
+    }
+    
+    return a_bpc_frame_check(s);                                                         /* check the frame */
+}
+#endif
+
+/**
+ * @brief     bpc decode frame
+ * @param[in] *handle pointer to a bpc handle structure
+ * @note      the frame is checked once all symbols are received, a parity error is
+ *            repaired in the soft decision mode and a damaged frame is replaced by
+ *            the vote of the frames in this minute
+ */
+static void a_bpc_decode_frame(bpc_handle_t *handle)
+{
+    uint8_t fail;
+    uint8_t repair;
+#if (BPC_VOTE != 0)
+    uint8_t pos;
+    uint8_t s[BPC_FRAME_SYMBOL_LEN];
+#endif
+    
+    repair = BPC_REPAIR_NONE;                                                            /* init none */
+    fail = a_bpc_frame_check(handle->decode_symbol);                                     /* check the frame */
+    if (((fail == BPC_FAIL_PARITY_FIRST) || (fail == BPC_FAIL_PARITY_SECOND)) && 
+        (handle->soft != 0))                                                             /* parity error in the soft mode */
+    {
+        fail = a_bpc_soft_repair(handle, handle->decode_symbol);                         /* flip the weakest symbol */
+        if (fail == BPC_FAIL_NONE)                                                       /* repaired */
+        {
+            BPC_STATS_ADD(handle, frame_repaired, 1);                                    /* repaired++ */
+            repair = BPC_REPAIR_SOFT;                                                    /* set soft */
+        }
+    }
+    if (handle->vote == 0)                                                               /* no vote */
+    {
+        if (fail == BPC_FAIL_NONE)                                                         /* the frame is valid */
+        {
+            a_bpc_decode_finished(handle, handle->decode_symbol, 
+                                  a_bpc_frame_confidence(handle), repair);               /* output the time */
+        }
+        else
+        {
+            a_bpc_decode_failed(handle, fail);                                           /* decode failed */
+        }
         
-        res = a_bpc_data_decode(handle, (uint32_t)handle->decode[ind].diff_us, &p4);            /* get data */
-        if (res != 0)                                                                           /* check the result */
+        return;                                                                          /* return */
+    }
+    
+#if (BPC_VOTE != 0)
+    pos = a_bpc_vote_push(handle, handle->decode_symbol);                                /* save the frame */
+    if (fail == BPC_FAIL_NONE)                                                             /* the frame is valid */
+    {
+        a_bpc_decode_finished(handle, handle->decode_symbol, 
+                              a_bpc_frame_confidence(handle), repair);                   /* output the time */
+    }
+    else if ((pos <= 2) && (a_bpc_vote_merge(handle, pos, s) == BPC_FAIL_NONE))         /* the vote is valid */
+    {
+        BPC_STATS_ADD(handle, frame_voted, 1);                                           /* voted++ */
+        a_bpc_decode_finished(handle, s, 0, BPC_REPAIR_VOTE);                            /* output the time */
+    }
+    else
+    {
+        a_bpc_decode_failed(handle, fail);                                               /* decode failed */
+    }
+#endif
+}
+
+/**
+ * @brief      bpc decode one interval
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[in]  diff_us diff time in us
+ * @param[out] *fail pointer to a fail reason buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame failed
+ * @note       the interval is the one decode_back intervals back in the delta ring,
+ *             the frame is start marker, p1, p2, hour, minute, week, p3, day, month, year and p4
+ */
+static uint8_t a_bpc_decode_step(bpc_handle_t *handle, uint32_t diff_us, uint8_t *fail)
+{
+    uint8_t res;
+    uint8_t ind;
+    uint8_t symbol;
+    uint32_t pulse_us;
+    uint32_t gap_us;
+    
+    if (handle->decode_valid == 0)                                                           /* search the start frame */
+    {
+        pulse_us = 0xFFFFFFFFU;                                                              /* no glitch */
+        gap_us = 0xFFFFFFFFU;                                                                /* no gap */
+        if ((diff_us < a_bpc_window_min(&handle->start_window)) && 
+            ((uint16_t)handle->decode_back + 2 < BPC_DELTA_BUFFER_SIZE))                    /* the gap before a glitch is buffered */
         {
-            data.status = BPC_STATUS_FRAME_INVALID;                                             /* frame invalid */
-            data.year = 0;                                                                      /* set 0 */
-            data.month = 0;                                                                     /* set 0 */
-            data.day = 0;                                                                       /* set 0 */
-            data.week = 0;                                                                      /* set 0 */
-            data.hour = 0;                                                                      /* set 0 */
-            data.minute = 0;                                                                    /* set 0 */
-            data.second = 0;                                                                    /* set 0 */
-            if (handle->receive_callback != NULL)                                               /* not null */
-            {
-                handle->receive_callback(&data);                                                /* run the callback */
-            }
-            
-            handle->decode_len = 0;                                                             /* clear the buffer */
-            handle->decode_offset = 0;                                                          /* init 0 */
-            handle->decode_valid = 0;                                                           /* set invalid */
-            handle->trace_valid = 0;                                                            /* set invalid */
-            
-            return;                                                                             /* return */
+            pulse_us = a_bpc_delta_get(handle, (uint8_t)(handle->decode_back + 1));          /* get the glitch pulse */
+            gap_us = a_bpc_delta_get(handle, (uint8_t)(handle->decode_back + 2));            /* get the gap before it */
+        }
+        if (a_check_start_frame(handle, diff_us) == 0)                                       /* check start frame */
+        {
+            handle->decode_joined = 0;                                                       /* not joined */
         }
+        else if ((pulse_us < a_bpc_window_min(&handle->data_window[0])) && 
+                 (gap_us < a_bpc_window_min(&handle->start_window)) && 
+                 (a_check_start_frame(handle, gap_us + pulse_us + diff_us) == 0))            /* start frame split by a glitch */
+        {
+            handle->decode_joined = 1;                                                       /* joined */
+        }
+        else
+        {
+            return 0;                                                                        /* success return 0 */
+        }
+        handle->decode_valid = 1;                                                            /* set valid */
+        handle->decode_index = 0;                                                            /* init 0 */
+        handle->decode_parity = 0;                                                           /* init 0 */
+        BPC_STATS_ADD(handle, start_frame, 1);                                               /* start frame++ */
         
-        count = 0;                                                                              /* init 0 */
-        parity = data.day;                                                                      /* set day */
-        while (parity != 0)                                                                     /* check 0 */
+        return 0;                                                                            /* success return 0 */
+    }
+    
+    if (handle->decode_index == (BPC_FRAME_INTERVAL_LEN - 1))                                /* p4 has no remain time */
+    {
+        res = a_bpc_symbol_decode(handle, diff_us, &symbol);                                 /* get data */
+        if (((handle->vote != 0) && (diff_us <= a_bpc_window_max(&handle->data_window[3]))) || 
+            ((handle->soft != 0) && (res == 0)))                                             /* check the frame at the end, a longer pulse is misaligned */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            handle->decode_symbol[BPC_FRAME_SYMBOL_LEN - 1] = (res != 0) ? BPC_SYMBOL_ERASED : symbol;  /* save p4 */
+            a_bpc_decode_frame(handle);                                                      /* output the time */
+            
+            return 0;                                                                        /* success return 0 */
         }
-        parity = data.month;                                                                    /* set month */
-        while (parity != 0)                                                                     /* check 0 */
+        if (res != 0)                                                                        /* check the result */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            *fail = BPC_FAIL_SYMBOL;                                                         /* symbol invalid */
+            
+            return 1;                                                                        /* return error */
         }
-        parity = data.year;                                                                     /* set year */
-        while (parity != 0)                                                                     /* check 0 */
+        if (((handle->decode_parity ^ symbol) & 0x1) != 0)                                   /* check day, month and year parity */
         {
-            count += parity & 0x1;                                                              /* add 1 */
-            parity >>= 1;                                                                       /* right shift */
+            *fail = BPC_FAIL_PARITY_SECOND;                                                  /* parity error */
+            
+            return 1;                                                                        /* return error */
         }
-        if (p4 == 0)                                                                            /* even */
+        handle->decode_symbol[BPC_FRAME_SYMBOL_LEN - 1] = symbol;                            /* save p4 */
+        a_bpc_decode_finished(handle, handle->decode_symbol, 
+                              a_bpc_frame_confidence(handle), BPC_REPAIR_NONE);              /* output the time */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    if ((handle->decode_index & 0x1) == 0)                                                   /* pulse time */
+    {
+        handle->decode_index++;                                                              /* index++ */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    
+    pulse_us = a_bpc_delta_get(handle, (uint8_t)(handle->decode_back + 1));                  /* get the pulse time */
+    ind = (uint8_t)(handle->decode_index >> 1);                                              /* get the symbol index */
+    res = a_bpc_data_decode2(handle, pulse_us, diff_us, &symbol);                            /* get data */
+    if ((res == 2) && (handle->vote != 0) && 
+        (pulse_us <= a_bpc_window_max(&handle->data_window[3])))                             /* the symbol is only damaged, a longer pulse is misaligned */
+    {
+        res = 0;                                                                             /* keep the frame for the vote */
+        symbol = BPC_SYMBOL_ERASED;                                                          /* erase the symbol */
+    }
+    if (res != 0)                                                                            /* check the result */
+    {
+        *fail = BPC_FAIL_SYMBOL;                                                             /* symbol invalid */
+        
+        return 1;                                                                            /* return error */
+    }
+    if ((handle->vote != 0) || (handle->soft != 0))                                          /* check the frame at the end */
+    {
+        handle->decode_symbol[ind] = symbol;                                                 /* save the symbol */
+        handle->decode_index++;                                                              /* index++ */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    if ((ind == 0) && (symbol > 2))                                                          /* p1 must be 19s, 39s or 59s */
+    {
+        *fail = BPC_FAIL_P1;                                                                 /* p1 invalid */
+        
+        return 1;                                                                            /* return error */
+    }
+    if (ind == 9)                                                                            /* p3 */
+    {
+        if (((handle->decode_parity ^ symbol) & 0x1) != 0)                                   /* check p1, p2, hour, minute and week parity */
         {
-            if ((count % 2) != 0)                                                               /* check even */
-            {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
-            }
-            data.year += 2000;                                                                  /* add 2000 */
+            *fail = BPC_FAIL_PARITY_FIRST;                                                   /* parity error */
+            
+            return 1;                                                                        /* return error */
         }
-        else if (p4 == 1)                                                                       /* odd */
+        handle->decode_parity = 0;                                                           /* restart for the second half */
+    }
+    else
+    {
+        handle->decode_parity ^= (uint8_t)((symbol ^ (symbol >> 1)) & 0x1);                  /* update the parity */
+    }
+    handle->decode_symbol[ind] = symbol;                                                     /* save the symbol */
+    handle->decode_index++;                                                                  /* index++ */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     bpc decode rescan
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] marker start frame position of the failed frame in the delta ring
+ * @note      the intervals after the failed start frame are decoded again, so the next
+ *            start frame inside them is found, a false start frame moves the scan on,
+ *            the replay stops after BPC_DECODE_RESCAN_MAX intervals, one pass of the ring,
+ *            and the frame in progress is dropped then
+ */
+static void a_bpc_decode_rescan(bpc_handle_t *handle, uint8_t marker)
+{
+    uint8_t back;
+    uint8_t fail;
+    uint8_t step;
+    
+    back = marker;                                                                           /* start from the failed start frame */
+    step = 0;                                                                                /* init 0 */
+    while ((back > 0) && (step < BPC_DECODE_RESCAN_MAX))                                     /* replay to the newest interval */
+    {
+        back--;                                                                              /* next interval */
+        step++;                                                                              /* step++ */
+        handle->decode_back = back;                                                          /* set the decode position */
+        if (a_bpc_decode_step(handle, a_bpc_delta_get(handle, back), &fail) != 0)            /* decode the interval */
         {
-            if ((count % 2) == 0)                                                               /* check even */
-            {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
-            }
-            data.year += 2000;                                                                  /* add 2000 */
+            back = (uint8_t)(back + handle->decode_index + 1);                               /* skip the false start frame */
+            a_bpc_decode_clear(handle);                                                      /* clear the frame */
         }
-        else if (p4 == 2)                                                                       /* even, year add */
+    }
+    if (back > 0)                                                                            /* the replay is cut */
+    {
+        a_bpc_decode_clear(handle);                                                          /* drop the frame in progress */
+    }
+    handle->decode_back = 0;                                                                 /* decode the newest interval */
+}
+
+/**
+ * @brief     bpc decode one interval
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] diff_us diff time in us
+ * @note      every interval is classified once when its closing edge arrives,
+ *            a failed frame rescans its intervals for the next start frame,
+ *            the worst case of one edge is 1 + BPC_DECODE_RESCAN_MAX decode steps
+ *            (38 with the default ring) and at most two frame checks, in the
+ *            task mode this work runs in bpc_process and not in the irq handler
+ */
+static void a_bpc_decode(bpc_handle_t *handle, uint32_t diff_us)
+{
+    uint8_t fail;
+    uint8_t marker;
+    
+    a_bpc_delta_push(handle, diff_us);                                                       /* save the interval */
+#if (BPC_COMPACT_DELTA != 0)
+    diff_us = a_bpc_delta_get(handle, 0);                                                    /* use the saved resolution */
+#endif
+#if (BPC_VOTE != 0)
+    handle->vote_clock += diff_us;                                                           /* update the vote clock */
+#endif
+    if (a_bpc_decode_step(handle, diff_us, &fail) != 0)                                      /* decode the interval */
+    {
+        marker = (uint8_t)(handle->decode_index + 1);                                        /* get the start frame position */
+        a_bpc_decode_failed(handle, fail);                                                   /* decode failed */
+        a_bpc_decode_rescan(handle, marker);                                                 /* rescan the intervals */
+    }
+}
+
+/**
+ * @brief     bpc edge decode
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *t pointer to an edge timestamp structure
+ * @note      none
+ */
+static void a_bpc_edge(bpc_handle_t *handle, const bpc_time_t *t)
+{
+    int64_t diff;
+#if (BPC_STATS_TIMING != 0)
+    bpc_time_t t0;
+    bpc_time_t t1;
+    uint8_t res;
+#endif
+    
+    BPC_STATS_ADD(handle, edge, 1);                                  /* edge++ */
+#if (BPC_LATEST != 0)
+    handle->edge_time = *t;                                          /* save the closing edge */
+#endif
+    diff = (int64_t)((int64_t)t->s - 
+           (int64_t)handle->last_time.s) * 1000000 + 
+           (int64_t)((int64_t)t->us - 
+           (int64_t)handle->last_time.us);                           /* now - last time */
+    if (diff - (int64_t)3000000L >= 0)                               /* if over 3s, force reset */
+    {
+        BPC_STATS_ADD(handle, timeout, 1);                           /* timeout++ */
+        a_bpc_decode_reset(handle);                                  /* reset the decoder */
+    }
+    else if (handle->last_valid != 0)                                /* check last time valid */
+    {
+#if (BPC_STATS_TIMING != 0)
+        res = handle->timestamp_read(&t0);                           /* read the start time */
+        a_bpc_decode(handle, (uint32_t)diff);                        /* decode the interval */
+        res |= handle->timestamp_read(&t1);                          /* read the stop time */
+        if (res == 0)                                                /* check the result */
         {
-            if ((count % 2) != 0)                                                               /* check even */
+            a_bpc_stats_begin(handle);                                                                /* begin the stats update */
+            handle->stats.decode_time_last_us = (uint32_t)((t1.s - t0.s) * 1000000 + t1.us - t0.us);  /* save the decode time */
+            if (handle->stats.decode_time_last_us > handle->stats.decode_time_max_us)                 /* check the max */
             {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
+                handle->stats.decode_time_max_us = handle->stats.decode_time_last_us;                 /* save the max */
             }
-            data.year += ((uint16_t)1 << 6);                                                    /* add year */
-            data.year += 2000;                                                                  /* add 2000 */
+            a_bpc_stats_end(handle);                                                                  /* end the stats update */
         }
-        else                                                                                    /* odd, year add */
+#else
+        a_bpc_decode(handle, (uint32_t)diff);                        /* decode the interval */
+#endif
+    }
+    else
+    {
+        /* the first edge after init has no interval */
+    }
+    handle->last_time.s = t->s;                                      /* save last time */
+    handle->last_time.us = t->us;                                    /* save last time */
+    handle->last_valid = 1;                                          /* set valid */
+}
+
+/**
+ * @brief     irq handler with an edge timestamp
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 fifo is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 t is NULL
+ * @note      t is the time when the edge occurred, e.g. a kernel event time or a timer capture value,
+ *            in the task mode the edge is only queued and bpc_process decodes it
+ */
+uint8_t bpc_irq_handler_at(bpc_handle_t *handle, const bpc_time_t *t)
+{
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if (t == NULL)                                                   /* check t */
+    {
+        return 4;                                                    /* return error */
+    }
+    
+#if (BPC_FIFO_SIZE != 0)
+    if (handle->mode == BPC_MODE_TASK)                               /* task mode */
+    {
+        uint8_t head;
+        uint8_t next;
+        
+        head = handle->fifo_head;                                    /* get the head */
+        next = (uint8_t)((head + 1) & (BPC_FIFO_SIZE - 1));          /* get the next head */
+        if (next == handle->fifo_tail)                               /* check full */
         {
-            if ((count % 2) == 0)                                                               /* check even */
-            {
-                data.status = BPC_STATUS_PARITY_ERR;                                            /* frame invalid */
-                data.year = 0;                                                                  /* set 0 */
-                data.month = 0;                                                                 /* set 0 */
-                data.day = 0;                                                                   /* set 0 */
-                data.week = 0;                                                                  /* set 0 */
-                data.hour = 0;                                                                  /* set 0 */
-                data.minute = 0;                                                                /* set 0 */
-                data.second = 0;                                                                /* set 0 */
-                if (handle->receive_callback != NULL)                                           /* not null */
-                {
-                    handle->receive_callback(&data);                                            /* run the callback */
-                }
-                
-                handle->decode_len = 0;                                                         /* clear the buffer */
-                handle->decode_offset = 0;                                                      /* init 0 */
-                handle->decode_valid = 0;                                                       /* set invalid */
-                handle->trace_valid = 0;                                                        /* set invalid */
-                
-                return;                                                                         /* return */
-            }
-            data.year += ((uint16_t)1 << 6);                                                    /* add year */
-            data.year += 2000;                                                                  /* add 2000 */
+            handle->fifo_full++;                                     /* only the irq handler writes it */
+            
+            return 1;                                                /* return error */
         }
+        handle->fifo[head].s = (uint32_t)t->s;                       /* save the low 32 bits of s */
+        handle->fifo[head].us = t->us;                               /* save us */
+        BPC_MEMORY_BARRIER();                                        /* publish the edge before the head */
+        handle->fifo_head = next;                                    /* set the head */
         
-        if (data.week == 7)                                                                     /* sunday is 7 in old version */
+        return 0;                                                    /* success return 0 */
+    }
+#endif
+    a_bpc_edge(handle, t);                                           /* decode the edge */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle pointer to a bpc handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bpc_irq_handler(bpc_handle_t *handle)
+{
+    uint8_t res;
+    bpc_time_t t;
+    
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    res = handle->timestamp_read(&t);                                /* timestamp read */
+    if (res != 0)                                                    /* check result */
+    {
+        handle->debug_print("bpc: timestamp read failed.\n");        /* timestamp read failed */
+        
+        return 1;                                                    /* return error */
+    }
+    
+    return bpc_irq_handler_at(handle, &t);                           /* run the irq handler */
+}
+
+/**
+ * @brief     decode an array of edge timestamps
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *edges pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 edges is NULL
+ * @note      edges must be in time order and continue the edges decoded before,
+ *            don't call it while the irq handler can run on the same handle
+ */
+uint8_t bpc_feed_edges(bpc_handle_t *handle, const bpc_time_t *edges, size_t n)
+{
+    size_t i;
+    uint64_t last_s;
+    uint32_t last_us;
+    int64_t diff;
+    
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if (n == 0)                                                      /* check length */
+    {
+        return 0;                                                    /* success return 0 */
+    }
+    if (edges == NULL)                                               /* check edges */
+    {
+        return 4;                                                    /* return error */
+    }
+    
+    BPC_STATS_ADD(handle, edge, (uint32_t)n);                        /* edge += n */
+    i = 0;                                                           /* init 0 */
+    if (handle->last_valid == 0)                                     /* check last time valid */
+    {
+        i = 1;                                                       /* the first edge has no interval */
+        last_s = edges[0].s;                                         /* set the first edge */
+        last_us = edges[0].us;                                       /* set the first edge */
+    }
+    else
+    {
+        last_s = handle->last_time.s;                                /* get last time */
+        last_us = handle->last_time.us;                              /* get last time */
+    }
+    for (; i < n; i++)                                               /* decode all intervals */
+    {
+        diff = (int64_t)((int64_t)edges[i].s - (int64_t)last_s) * 1000000 + 
+               (int64_t)((int64_t)edges[i].us - (int64_t)last_us);   /* now - last time */
+        if (diff - (int64_t)3000000L >= 0)                           /* if over 3s, force reset */
         {
-            data.week = 0;                                                                      /* set 0 */
+            BPC_STATS_ADD(handle, timeout, 1);                       /* timeout++ */
+            a_bpc_decode_reset(handle);                              /* reset the decoder */
         }
-        data.status = BPC_STATUS_OK;                                                            /* set ok */
-        if (handle->receive_callback != NULL)                                                   /* not null */
+        else
         {
-            handle->receive_callback(&data);                                                    /* run the callback */
+#if (BPC_LATEST != 0)
+            handle->edge_time = edges[i];                            /* save the closing edge */
+#endif
+            a_bpc_decode(handle, (uint32_t)diff);                    /* decode the interval */
         }
+        last_s = edges[i].s;                                         /* save last time */
+        last_us = edges[i].us;                                       /* save last time */
+    }
+    handle->last_time.s = last_s;                                    /* save last time */
+    handle->last_time.us = last_us;                                  /* save last time */
+    handle->last_valid = 1;                                          /* set valid */
+    
+    return 0;                                                        /* success return 0 */
+}
 
-        handle->decode_len = 0;                                                                 /* clear the buffer */
-        handle->decode_offset = 0;                                                              /* init 0 */
-        handle->decode_valid = 0;                                                               /* set invalid */
-        handle->trace_valid = 1;                                                                /* set valid */
+/**
+ * @brief     decode one pulse and period pair
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us from the pulse start to the next pulse start
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 t is NULL
+ * @note      the pair is what a timer in the pwm input mode captures once per second, the period
+ *            over the missing second carries the start frame, a pair with the width not shorter
+ *            than the period or the period over 3s resets the decoder, the frame is output with the
+ *            pair of p4 at the next pulse start, don't call it while the irq handler can run on the same handle
+ */
+uint8_t bpc_feed_pulse(bpc_handle_t *handle, const bpc_time_t *t, uint32_t width_us, uint32_t period_us)
+{
+    int64_t diff;
+    
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if (t == NULL)                                                   /* check t */
+    {
+        return 4;                                                    /* return error */
+    }
+    
+    BPC_STATS_ADD(handle, edge, 2);                                  /* both edges of the pulse */
+    diff = (int64_t)((int64_t)t->s - 
+           (int64_t)handle->last_time.s) * 1000000 + 
+           (int64_t)((int64_t)t->us - 
+           (int64_t)handle->last_time.us);                           /* now - last time */
+    if (((handle->last_valid != 0) && (diff - (int64_t)3000000L >= 0)) || 
+        (period_us >= 3000000U))                                     /* if over 3s, force reset */
+    {
+        BPC_STATS_ADD(handle, timeout, 1);                           /* timeout++ */
+        a_bpc_decode_reset(handle);                                  /* reset the decoder */
+    }
+    if (width_us >= period_us)                                       /* check the pair */
+    {
+        a_bpc_decode_reset(handle);                                  /* reset the decoder */
+    }
+    else if (period_us < 3000000U)                                   /* the pair carries both intervals */
+    {
+#if (BPC_LATEST != 0)
+        a_bpc_time_back(t, period_us - width_us, &handle->edge_time);  /* the pulse end */
+#endif
+        a_bpc_decode(handle, width_us);                              /* decode the pulse time */
+#if (BPC_LATEST != 0)
+        handle->edge_time = *t;                                      /* the next pulse start */
+#endif
+        a_bpc_decode(handle, period_us - width_us);                  /* decode the remain time */
     }
+    handle->last_time.s = t->s;                                      /* save last time */
+    handle->last_time.us = t->us;                                    /* save last time */
+    handle->last_valid = 1;                                          /* set valid */
+    
+    return 0;                                                        /* success return 0 */
 }
 
 /**
- * @brief     irq handler
+ * @brief     process the queued edges
  * @param[in] *handle pointer to a bpc handle structure
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      call it from the main loop or a task in the task mode,
+ *            the decoding and receive_callback run in the caller's context
  */
-uint8_t bpc_irq_handler(bpc_handle_t *handle)
+uint8_t bpc_process(bpc_handle_t *handle)
 {
-    uint8_t res;
-    int64_t diff;
+#if (BPC_FIFO_SIZE != 0)
+    uint8_t tail;
     bpc_time_t t;
+#endif
     
     if (handle == NULL)                                              /* check handle */
     {
@@ -1136,51 +1565,85 @@ uint8_t bpc_irq_handler(bpc_handle_t *handle)
         return 3;                                                    /* return error */
     }
     
-    res = handle->timestamp_read(&t);                                /* timestamp read */
-    if (res != 0)                                                    /* check result */
+#if (BPC_FIFO_SIZE != 0)
+    tail = handle->fifo_tail;                                        /* get the tail */
+    while (tail != handle->fifo_head)                                /* check empty */
     {
-        handle->debug_print("bpc: timestamp read failed.\n");        /* timestamp read failed */
-        
-        return 1;                                                    /* return error */
+        BPC_MEMORY_BARRIER();                                        /* read the edge after the head */
+        t.s = handle->last_time.s + 
+              (uint64_t)(int64_t)(int32_t)(handle->fifo[tail].s - 
+              (uint32_t)handle->last_time.s);                        /* the s nearest the last time */
+        t.us = handle->fifo[tail].us;                                /* get us */
+        BPC_MEMORY_BARRIER();                                        /* read the edge before freeing it */
+        tail = (uint8_t)((tail + 1) & (BPC_FIFO_SIZE - 1));          /* get the next tail */
+        handle->fifo_tail = tail;                                    /* set the tail */
+        a_bpc_edge(handle, &t);                                      /* decode the edge */
     }
-    diff = (int64_t)((int64_t)t.s - 
-           (int64_t)handle->last_time.s) * 1000000 + 
-           (int64_t)((int64_t)t.us - 
-           (int64_t)handle->last_time.us);                           /* now - last time */
-    if (diff - (int64_t)3000000L >= 0)                               /* if over 3s, force reset */
+#endif
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     set the process mode
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] mode process mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 task mode is disabled
+ * @note      set the mode when the edge irq is disabled, the queued edges are dropped
+ */
+uint8_t bpc_set_mode(bpc_handle_t *handle, bpc_mode_t mode)
+{
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
     {
-        handle->decode_len = 0;                                      /* reset the decode */
-        handle->decode_offset = 0;                                   /* set 0 */
-        handle->decode_valid = 0;                                    /* set invalid */
-        handle->trace_valid = 0;                                     /* set invalid */
+        return 3;                                                    /* return error */
     }
-    if (handle->decode_len >= 76)                                    /* check the max length */
+    
+#if (BPC_FIFO_SIZE != 0)
+    handle->fifo_head = 0;                                           /* init 0 */
+    handle->fifo_tail = 0;                                           /* init 0 */
+#else
+    if (mode == BPC_MODE_TASK)                                       /* check the mode */
     {
-        handle->decode_len = 0;                                      /* reset the decode */
-        handle->decode_offset = 0;                                   /* set 0 */
-        handle->decode_valid = 0;                                    /* set invalid */
-        handle->trace_valid = 0;                                     /* set invalid */
+        handle->debug_print("bpc: task mode is disabled.\n");        /* task mode is disabled */
+        
+        return 4;                                                    /* return error */
     }
-    handle->decode[handle->decode_len].t.s = t.s;                    /* save s */
-    handle->decode[handle->decode_len].t.us = t.us;                  /* save us */
-    handle->decode_len++;                                            /* length++ */
-    if (handle->trace_valid != 0)                                    /* check trace valid */
+#endif
+    handle->mode = (uint8_t)mode;                                    /* set the mode */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the process mode
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *mode pointer to a process mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_mode(bpc_handle_t *handle, bpc_mode_t *mode)
+{
+    if (handle == NULL)                                              /* check handle */
     {
-        a_bpc_trace_decode(handle);                                  /* try to trace decode */
+        return 2;                                                    /* return error */
     }
-    if (handle->decode_len >= 38)                                    /* check the end length */
+    if (handle->inited != 1)                                         /* check handle initialization */
     {
-        if (handle->decode_valid != 0)                               /* check decode valid */
-        {
-            a_bpc_decode(handle);                                    /* try to decode */
-        }
-        else
-        {
-            a_bpc_start_decode(handle);                              /* try to decode starter */
-        }
+        return 3;                                                    /* return error */
     }
-    handle->last_time.s = t.s;                                       /* save last time */
-    handle->last_time.us = t.us;                                     /* save last time */
+    
+    *mode = (bpc_mode_t)(handle->mode);                              /* get the mode */
     
     return 0;                                                        /* success return 0 */
 }
@@ -1236,10 +1699,45 @@ uint8_t bpc_init(bpc_handle_t *handle)
     }
     handle->last_time.s = t.s;                                          /* save last time */
     handle->last_time.us = t.us;                                        /* save last time */
-    handle->decode_len = 0;                                             /* init 0 */
-    handle->decode_offset = 0;                                          /* init 0 */
+    handle->start_range = BPC_DEFAULT_START_RANGE;                      /* set the default start range */
+    handle->range = BPC_DEFAULT_RANGE;                                  /* set the default range */
+    a_bpc_window_update(handle);                                        /* update the windows */
+    handle->delta_head = 0;                                             /* init 0 */
+#if (BPC_FIFO_SIZE != 0)
+    handle->fifo_head = 0;                                              /* init 0 */
+    handle->fifo_tail = 0;                                              /* init 0 */
+    handle->fifo_full = 0;                                              /* init 0 */
+    handle->fifo_full_base = 0;                                         /* init 0 */
+#endif
+    handle->mode = BPC_MODE_IRQ;                                        /* set the irq mode */
+    handle->last_valid = 0;                                             /* set invalid */
     handle->decode_valid = 0;                                           /* set invalid */
-    handle->trace_valid = 0;                                            /* set invalid */
+    handle->decode_index = 0;                                           /* init 0 */
+    handle->decode_parity = 0;                                          /* init 0 */
+    handle->decode_back = 0;                                            /* init 0 */
+    handle->decode_joined = 0;                                          /* not joined */
+    handle->soft = 0;                                                   /* disable the soft decision */
+    handle->vote = 0;                                                   /* disable the vote */
+#if (BPC_VOTE != 0)
+    handle->vote_mask = 0;                                              /* init 0 */
+    handle->vote_clock = 0;                                             /* init 0 */
+#endif
+#if (BPC_STATS != 0)
+    memset(&handle->stats, 0, sizeof(bpc_stats_t));                     /* clear the stats */
+    handle->stats_seq = 0;                                              /* init 0 */
+#endif
+#if (BPC_LATEST != 0)
+    handle->ref_valid = 0;                                              /* set invalid */
+    memset(handle->latest, 0, sizeof(bpc_latest_t) * 2);                /* clear the latest */
+    handle->latest[0].data.status = BPC_STATUS_FRAME_INVALID;           /* no ok frame */
+    handle->latest[1].data.status = BPC_STATUS_FRAME_INVALID;           /* no ok frame */
+    handle->latest[0].status = BPC_STATUS_FRAME_INVALID;                /* no frame */
+    handle->latest[1].status = BPC_STATUS_FRAME_INVALID;                /* no frame */
+    handle->latest_seq[0] = 0;                                          /* init 0 */
+    handle->latest_seq[1] = 0;                                          /* init 0 */
+    handle->latest_index = 0;                                           /* init 0 */
+    handle->latest_valid = 0;                                           /* set invalid */
+#endif
     handle->inited = 1;                                                 /* flag inited */
     
     return 0;                                                           /* success return 0 */
@@ -1271,7 +1769,386 @@ uint8_t bpc_deinit(bpc_handle_t *handle)
 }
 
 /**
- * @brief      get chip's information
+ * @brief     set the decode tolerance
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] start_percent start frame tolerance in percent
+ * @param[in] percent data and frame tolerance in percent
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 percent is over 100
+ * @note      bpc_init sets BPC_MAX_START_RANGE and BPC_MAX_RANGE as the default tolerance
+ */
+uint8_t bpc_set_tolerance(bpc_handle_t *handle, uint8_t start_percent, uint8_t percent)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if ((start_percent > 100) || (percent > 100))                        /* check the percent */
+    {
+        handle->debug_print("bpc: percent is over 100.\n");              /* percent is over 100 */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    handle->start_range = start_percent;                                 /* set the start range */
+    handle->range = percent;                                             /* set the range */
+    a_bpc_window_update(handle);                                         /* update the windows */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the decode tolerance
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *start_percent pointer to a start frame tolerance buffer
+ * @param[out] *percent pointer to a data and frame tolerance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_tolerance(bpc_handle_t *handle, uint8_t *start_percent, uint8_t *percent)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *start_percent = handle->start_range;                                /* get the start range */
+    *percent = handle->range;                                            /* get the range */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the soft decision
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      each pulse takes the nearest nominal time and a parity error is repaired
+ *            by flipping the least confident symbol of that half when it is clearly the
+ *            weakest one, the repaired frame is ok with repair BPC_REPAIR_SOFT
+ */
+uint8_t bpc_set_soft_decision(bpc_handle_t *handle, bpc_bool_t enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    handle->soft = (uint8_t)enable;                                      /* set the soft decision */
+    a_bpc_decode_reset(handle);                                          /* restart the frame */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the soft decision status
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_soft_decision(bpc_handle_t *handle, bpc_bool_t *enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *enable = (bpc_bool_t)(handle->soft);                                /* get the soft decision */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the multi-frame vote
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 vote is disabled
+ * @note      the vote keeps the symbols of the 19s, 39s and 59s frames of one minute,
+ *            a damaged frame is output with repair BPC_REPAIR_VOTE when the voted symbols
+ *            pass both parity checks
+ */
+uint8_t bpc_set_vote(bpc_handle_t *handle, bpc_bool_t enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+#if (BPC_VOTE == 0)
+    if (enable != BPC_BOOL_FALSE)                                        /* check the vote */
+    {
+        handle->debug_print("bpc: vote is disabled.\n");                 /* vote is disabled */
+        
+        return 4;                                                        /* return error */
+    }
+#endif
+    
+    handle->vote = (uint8_t)enable;                                      /* set the vote */
+    a_bpc_decode_reset(handle);                                          /* restart the frame */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the multi-frame vote status
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_vote(bpc_handle_t *handle, bpc_bool_t *enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *enable = (bpc_bool_t)(handle->vote);                                /* get the vote */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the reference edge time of the last fix
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *t pointer to an edge timestamp structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no fix
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 latest is disabled
+ * @note       the edge starting the p4 pulse is at the second of the fix, call it in the receive callback
+ *             or in the decoding context
+ */
+uint8_t bpc_get_reference_time(bpc_handle_t *handle, bpc_time_t *t)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+#if (BPC_LATEST == 0)
+    (void)t;
+    
+    return 4;                                                            /* return error */
+#else
+    if (handle->ref_valid == 0)                                          /* check the fix */
+    {
+        return 1;                                                        /* return error */
+    }
+    
+    t->s = handle->ref_time.s;                                           /* copy s */
+    t->us = handle->ref_time.us;                                         /* copy us */
+    
+    return 0;                                                            /* success return 0 */
+#endif
+}
+
+/**
+ * @brief      read the latest frame
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *latest pointer to a bpc latest structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 latest is busy
+ *             - 5 latest is disabled
+ * @note       it can run in any number of other contexts, the decoder publishes into the other slot
+ *             and never waits for the readers, the read is lock free but not wait free, it retries
+ *             BPC_LATEST_READ_RETRY times when the decoder publishes during the copy and returns 4
+ *             when the decoder keeps lapping it, the caller can call it again later
+ */
+uint8_t bpc_read_latest(bpc_handle_t *handle, bpc_latest_t *latest)
+{
+#if (BPC_LATEST != 0)
+    uint8_t i;
+    uint8_t index;
+    uint32_t seq;
+#endif
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+#if (BPC_LATEST == 0)
+    (void)latest;
+    
+    return 5;                                                            /* return error */
+#else
+    if (handle->latest_valid == 0)                                       /* check the frame */
+    {
+        return 1;                                                        /* return error */
+    }
+    
+    for (i = 0; i < BPC_LATEST_READ_RETRY; i++)                          /* retry only when lapped twice */
+    {
+        index = handle->latest_index;                                    /* get the published slot */
+        BPC_MEMORY_BARRIER();                                            /* index before the seq */
+        seq = handle->latest_seq[index];                                 /* get the sequence */
+        BPC_MEMORY_BARRIER();                                            /* seq before the slot */
+        if ((seq & 0x1) != 0)                                            /* updating */
+        {
+            continue;                                                    /* retry */
+        }
+        memcpy(latest, &handle->latest[index], sizeof(bpc_latest_t));    /* copy the slot */
+        BPC_MEMORY_BARRIER();                                            /* slot before the seq */
+        if (seq == handle->latest_seq[index])                            /* not changed */
+        {
+            return 0;                                                    /* success return 0 */
+        }
+    }
+    
+    return 4;                                                            /* return error */
+#endif
+}
+
+/**
+ * @brief      get the stats
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *stats pointer to a bpc stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stats is busy
+ *             - 5 stats is disabled
+ * @note       it can run in another context or in the receive callback, the copy is retried while
+ *             a counter changes, it is busy only when every retry meets an update
+ */
+uint8_t bpc_get_stats(bpc_handle_t *handle, bpc_stats_t *stats)
+{
+#if (BPC_STATS != 0)
+    uint8_t i;
+    uint32_t seq;
+#endif
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+#if (BPC_STATS == 0)
+    (void)stats;
+    
+    return 5;                                                            /* return error */
+#else
+    for (i = 0; i < BPC_STATS_READ_RETRY; i++)                           /* retry */
+    {
+        seq = handle->stats_seq;                                         /* get the sequence */
+        BPC_MEMORY_BARRIER();                                            /* seq before the stats */
+        if ((seq & 0x1) != 0)                                            /* updating */
+        {
+            continue;                                                    /* retry */
+        }
+        memcpy(stats, &handle->stats, sizeof(bpc_stats_t));              /* copy the stats */
+#if (BPC_FIFO_SIZE != 0)
+        stats->fifo_full = handle->fifo_full - handle->fifo_full_base;   /* the full count since the reset */
+#endif
+        BPC_MEMORY_BARRIER();                                            /* stats before the seq */
+        if (seq == handle->stats_seq)                                    /* not changed */
+        {
+            return 0;                                                    /* success return 0 */
+        }
+    }
+    
+    return 4;                                                            /* return error */
+#endif
+}
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to a bpc handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 stats is disabled
+ * @note      call it in the decoding context, e.g. the receive callback, or when the edge irq is disabled
+ */
+uint8_t bpc_reset_stats(bpc_handle_t *handle)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+#if (BPC_STATS == 0)
+    return 4;                                                            /* return error */
+#else
+    a_bpc_stats_begin(handle);                                           /* begin the stats update */
+    memset(&handle->stats, 0, sizeof(bpc_stats_t));                      /* clear the stats */
+#if (BPC_FIFO_SIZE != 0)
+    handle->fifo_full_base = handle->fifo_full;                          /* the irq handler owns the full count */
+#endif
+    a_bpc_stats_end(handle);                                             /* end the stats update */
+    
+    return 0;                                                            /* success return 0 */
+#endif
+}
+
+/**
+ * @brief     get chip's information
  * @param[out] *info pointer to a bpc info structure
  * @return     status code
  *             - 0 success
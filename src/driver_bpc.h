@@ -57,19 +57,98 @@ extern "C"{
  */
 
 /**
- * @brief bpc max start range definition
+ * @brief bpc default max start range definition
  */
 #ifndef BPC_MAX_START_RANGE
     #define BPC_MAX_START_RANGE        0.20f        /**< 20% */
 #endif
 
 /**
- * @brief bpc max range definition
+ * @brief bpc default max range definition
  */
 #ifndef BPC_MAX_RANGE
     #define BPC_MAX_RANGE        0.20f        /**< 20% */
 #endif
 
+/**
+ * @brief bpc delta buffer size definition
+ */
+#ifndef BPC_DELTA_BUFFER_SIZE
+    #define BPC_DELTA_BUFFER_SIZE        38        /**< one frame of intervals, from 38 to 255 */
+#endif
+
+/**
+ * @brief bpc fifo size definition
+ */
+#ifndef BPC_FIFO_SIZE
+    #define BPC_FIFO_SIZE        8        /**< task mode edge fifo depth, power of 2, 0 removes the task mode */
+#endif
+
+/**
+ * @brief bpc vote definition
+ */
+#ifndef BPC_VOTE
+    #define BPC_VOTE        1        /**< 1: keep the frames of one minute for the vote, 0: remove the vote */
+#endif
+
+/**
+ * @brief bpc latest definition
+ */
+#ifndef BPC_LATEST
+    #define BPC_LATEST        1        /**< 1: keep the latest frame and its reference time, 0: remove them */
+#endif
+
+/**
+ * @brief bpc stats definition
+ */
+#ifndef BPC_STATS
+    #define BPC_STATS        1        /**< 1: count the decoder events, 0: remove the stats */
+#endif
+
+/**
+ * @brief bpc compact delta definition
+ */
+#ifndef BPC_COMPACT_DELTA
+    #define BPC_COMPACT_DELTA        0        /**< 0: 32 bits us delta, 1: 16 bits ms delta */
+#endif
+
+/**
+ * @brief bpc stats timing definition
+ */
+#ifndef BPC_STATS_TIMING
+    #define BPC_STATS_TIMING        0        /**< 1: time every edge decode with timestamp_read */
+#endif
+
+/**
+ * @brief bpc memory barrier definition
+ */
+#ifndef BPC_MEMORY_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define BPC_MEMORY_BARRIER()        __sync_synchronize()        /**< full memory barrier */
+    #else
+        #define BPC_MEMORY_BARRIER()                                    /**< define it for your compiler */
+    #endif
+#endif
+
+/**
+ * @brief bpc frame symbol length definition
+ */
+#define BPC_FRAME_SYMBOL_LEN        19        /**< p1, p2, hour, minute, week, p3, day, month, year and p4 */
+
+/**
+ * @brief bpc vote frame length definition
+ */
+#define BPC_VOTE_FRAME_LEN        3        /**< frames of 19s, 39s and 59s in one minute */
+
+/**
+ * @brief bpc bool enumeration definition
+ */
+typedef enum
+{
+    BPC_BOOL_FALSE = 0x00,        /**< false */
+    BPC_BOOL_TRUE  = 0x01,        /**< true */
+} bpc_bool_t;
+
 /**
  * @brief bpc status enumeration definition
  */
@@ -80,6 +159,25 @@ typedef enum
     BPC_STATUS_FRAME_INVALID = 0x02,        /**< frame invalid */
 } bpc_status_t;
 
+/**
+ * @brief bpc repair enumeration definition
+ */
+typedef enum
+{
+    BPC_REPAIR_NONE = 0x00,        /**< received as is */
+    BPC_REPAIR_SOFT = 0x01,        /**< one symbol of a half flipped by the soft decision */
+    BPC_REPAIR_VOTE = 0x02,        /**< voted from the frames of one minute */
+} bpc_repair_t;
+
+/**
+ * @brief bpc mode enumeration definition
+ */
+typedef enum
+{
+    BPC_MODE_IRQ  = 0x00,        /**< decode in the irq handler */
+    BPC_MODE_TASK = 0x01,        /**< queue in the irq handler and decode in bpc_process */
+} bpc_mode_t;
+
 /**
  * @brief bpc structure definition
  */
@@ -93,6 +191,8 @@ typedef struct bpc_s
     uint8_t hour;         /**< hour */
     uint8_t minute;       /**< minute */
     uint8_t second;       /**< second */
+    uint8_t confidence;   /**< lowest symbol confidence in percent, 0 when repaired */
+    uint8_t repair;       /**< repair of an ok frame, a repaired frame is a guess and less trusted */
 } bpc_t;
 
 /**
@@ -105,13 +205,61 @@ typedef struct bpc_time_s
 } bpc_time_t;
 
 /**
- * @brief bpc decode structure definition
+ * @brief bpc delta type definition
+ */
+#if (BPC_COMPACT_DELTA != 0)
+typedef uint16_t bpc_delta_t;        /**< interval in ms */
+#else
+typedef uint32_t bpc_delta_t;        /**< interval in us */
+#endif
+
+/**
+ * @brief bpc window structure definition
+ */
+typedef struct bpc_window_s
+{
+    bpc_delta_t min;        /**< min time in the delta resolution */
+    bpc_delta_t max;        /**< max time in the delta resolution */
+} bpc_window_t;
+
+/**
+ * @brief bpc stats structure definition
  */
-typedef struct bpc_decode_s
+typedef struct bpc_stats_s
 {
-    bpc_time_t t;        /**< timestamp */
-    uint32_t diff_us;    /**< diff us */
-} bpc_decode_t;
+    uint32_t edge;                       /**< decoded edge count */
+    uint32_t fifo_full;                  /**< edge dropped by the full fifo */
+    uint32_t timeout;                    /**< 3s timeout count */
+    uint32_t start_frame;                /**< start frame count */
+    uint32_t frame_ok;                   /**< ok frame count */
+    uint32_t frame_repaired;             /**< ok frame repaired by the soft decision */
+    uint32_t frame_voted;                /**< ok frame recovered by the vote */
+    uint32_t symbol_invalid;             /**< frame failed by a symbol out of the windows */
+    uint32_t p1_invalid;                 /**< frame failed by p1 over 2 */
+    uint32_t parity_first;               /**< frame failed by the p3 parity */
+    uint32_t parity_second;              /**< frame failed by the p4 parity */
+    uint32_t decode_time_last_us;        /**< last edge decode time in us, needs BPC_STATS_TIMING */
+    uint32_t decode_time_max_us;         /**< max edge decode time in us, needs BPC_STATS_TIMING */
+} bpc_stats_t;
+
+/**
+ * @brief bpc latest structure definition
+ */
+typedef struct bpc_latest_s
+{
+    bpc_t data;                /**< latest ok frame, data.status is not ok before the first fix */
+    bpc_time_t ref_time;       /**< reference edge time of the latest ok frame */
+    uint8_t status;            /**< status of the latest frame */
+} bpc_latest_t;
+
+/**
+ * @brief bpc fifo structure definition
+ */
+typedef struct bpc_fifo_s
+{
+    uint32_t s;         /**< low 32 bits of the second */
+    uint32_t us;        /**< microsecond */
+} bpc_fifo_t;
 
 /**
  * @brief bpc handle structure definition
@@ -122,13 +270,51 @@ typedef struct bpc_handle_s
     void (*delay_ms)(uint32_t ms);                          /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);        /**< point to a debug_print function address */
     void (*receive_callback)(bpc_t *data);                  /**< point to a receive_callback function address */
-    uint8_t inited;                                         /**< inited flag */
-    bpc_decode_t decode[76];                                /**< decode buffer */
-    uint16_t decode_len;                                    /**< decode length */
     bpc_time_t last_time;                                   /**< last time */
-    uint8_t decode_offset;                                  /**< decode offset */
+#if (BPC_LATEST != 0)
+    bpc_time_t edge_time;                                   /**< time of the edge closing the decoded interval */
+    bpc_time_t ref_time;                                    /**< reference edge time of the last fix */
+    bpc_latest_t latest[2];                                 /**< latest frame slots */
+    volatile uint32_t latest_seq[2];                        /**< latest frame slot sequence, odd while updating */
+    volatile uint8_t latest_index;                          /**< published latest frame slot */
+    volatile uint8_t latest_valid;                          /**< latest frame valid */
+    uint8_t ref_valid;                                      /**< reference edge time valid */
+#endif
+    bpc_window_t data_window[4];                            /**< data 0 - 3 windows */
+    bpc_window_t frame_window;                              /**< frame window */
+    bpc_window_t start_window;                              /**< start frame window */
+    bpc_delta_t delta[BPC_DELTA_BUFFER_SIZE];               /**< interval ring buffer */
+#if (BPC_STATS != 0)
+    bpc_stats_t stats;                                      /**< stats */
+    volatile uint32_t stats_seq;                            /**< stats sequence, odd while updating */
+#endif
+#if (BPC_FIFO_SIZE != 0)
+    bpc_fifo_t fifo[BPC_FIFO_SIZE];                         /**< edge fifo */
+    volatile uint32_t fifo_full;                            /**< edge fifo full count, written by the irq handler */
+    uint32_t fifo_full_base;                                /**< edge fifo full count at the stats reset */
+    volatile uint8_t fifo_head;                             /**< edge fifo head, written by the irq handler */
+    volatile uint8_t fifo_tail;                             /**< edge fifo tail, written by bpc_process */
+#endif
+#if (BPC_VOTE != 0)
+    uint32_t vote_clock;                                    /**< sum of the decoded intervals in us */
+    uint32_t vote_time[BPC_VOTE_FRAME_LEN];                 /**< vote frame end time in us */
+    uint8_t vote_mask;                                      /**< vote frame valid mask */
+    uint8_t vote_symbol[BPC_VOTE_FRAME_LEN][BPC_FRAME_SYMBOL_LEN];        /**< vote symbol buffer */
+#endif
+    uint8_t mode;                                           /**< process mode */
+    uint8_t delta_head;                                     /**< interval ring buffer head */
+    uint8_t inited;                                         /**< inited flag */
+    uint8_t start_range;                                    /**< start range in percent */
+    uint8_t range;                                          /**< range in percent */
+    uint8_t last_valid;                                     /**< last time valid */
     uint8_t decode_valid;                                   /**< decode valid */
-    uint8_t trace_valid;                                    /**< trace valid */
+    uint8_t decode_index;                                   /**< decode interval index */
+    uint8_t decode_parity;                                  /**< decode parity */
+    uint8_t decode_back;                                    /**< decode interval position in the delta ring */
+    uint8_t decode_joined;                                  /**< decode start frame joined across a glitch */
+    uint8_t decode_symbol[BPC_FRAME_SYMBOL_LEN];            /**< decode symbol buffer */
+    uint8_t soft;                                           /**< soft decision enable */
+    uint8_t vote;                                           /**< vote enable */
 } bpc_handle_t;
 
 /**
@@ -231,6 +417,91 @@ uint8_t bpc_info(bpc_info_t *info);
  */
 uint8_t bpc_irq_handler(bpc_handle_t *handle);
 
+/**
+ * @brief     irq handler with an edge timestamp
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 fifo is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 t is NULL
+ * @note      t is the time when the edge occurred, e.g. a kernel event time or a timer capture value,
+ *            in the task mode the edge is only queued and bpc_process decodes it
+ */
+uint8_t bpc_irq_handler_at(bpc_handle_t *handle, const bpc_time_t *t);
+
+/**
+ * @brief     decode an array of edge timestamps
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *edges pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 edges is NULL
+ * @note      edges must be in time order and continue the edges decoded before,
+ *            don't call it while the irq handler can run on the same handle
+ */
+uint8_t bpc_feed_edges(bpc_handle_t *handle, const bpc_time_t *edges, size_t n);
+
+/**
+ * @brief     decode one pulse and period pair
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us from the pulse start to the next pulse start
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 t is NULL
+ * @note      the pair is what a timer in the pwm input mode captures once per second, the period
+ *            over the missing second carries the start frame, a pair with the width not shorter
+ *            than the period or the period over 3s resets the decoder, the frame is output with the
+ *            pair of p4 at the next pulse start, don't call it while the irq handler can run on the same handle
+ */
+uint8_t bpc_feed_pulse(bpc_handle_t *handle, const bpc_time_t *t, uint32_t width_us, uint32_t period_us);
+
+/**
+ * @brief     process the queued edges
+ * @param[in] *handle pointer to a bpc handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from the main loop or a task in the task mode,
+ *            the decoding and receive_callback run in the caller's context
+ */
+uint8_t bpc_process(bpc_handle_t *handle);
+
+/**
+ * @brief     set the process mode
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] mode process mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 task mode is disabled
+ * @note      set the mode when the edge irq is disabled, the queued edges are dropped
+ */
+uint8_t bpc_set_mode(bpc_handle_t *handle, bpc_mode_t mode);
+
+/**
+ * @brief      get the process mode
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *mode pointer to a process mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_mode(bpc_handle_t *handle, bpc_mode_t *mode);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a bpc handle structure
@@ -254,6 +525,146 @@ uint8_t bpc_init(bpc_handle_t *handle);
  */
 uint8_t bpc_deinit(bpc_handle_t *handle);
 
+/**
+ * @brief     set the decode tolerance
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] start_percent start frame tolerance in percent
+ * @param[in] percent data and frame tolerance in percent
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 percent is over 100
+ * @note      bpc_init sets BPC_MAX_START_RANGE and BPC_MAX_RANGE as the default tolerance
+ */
+uint8_t bpc_set_tolerance(bpc_handle_t *handle, uint8_t start_percent, uint8_t percent);
+
+/**
+ * @brief      get the decode tolerance
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *start_percent pointer to a start frame tolerance buffer
+ * @param[out] *percent pointer to a data and frame tolerance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_tolerance(bpc_handle_t *handle, uint8_t *start_percent, uint8_t *percent);
+
+/**
+ * @brief     enable or disable the soft decision
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      each pulse takes the nearest nominal time and a parity error is repaired
+ *            by flipping the least confident symbol of that half when it is clearly the
+ *            weakest one, the repaired frame is ok with repair BPC_REPAIR_SOFT
+ */
+uint8_t bpc_set_soft_decision(bpc_handle_t *handle, bpc_bool_t enable);
+
+/**
+ * @brief      get the soft decision status
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_soft_decision(bpc_handle_t *handle, bpc_bool_t *enable);
+
+/**
+ * @brief     enable or disable the multi-frame vote
+ * @param[in] *handle pointer to a bpc handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 vote is disabled
+ * @note      the vote keeps the symbols of the 19s, 39s and 59s frames of one minute,
+ *            a damaged frame is output with repair BPC_REPAIR_VOTE when the voted symbols
+ *            pass both parity checks
+ */
+uint8_t bpc_set_vote(bpc_handle_t *handle, bpc_bool_t enable);
+
+/**
+ * @brief      get the multi-frame vote status
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bpc_get_vote(bpc_handle_t *handle, bpc_bool_t *enable);
+
+/**
+ * @brief      get the reference edge time of the last fix
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *t pointer to an edge timestamp structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no fix
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 latest is disabled
+ * @note       the edge starting the p4 pulse is at the second of the fix, call it in the receive callback
+ *             or in the decoding context
+ */
+uint8_t bpc_get_reference_time(bpc_handle_t *handle, bpc_time_t *t);
+
+/**
+ * @brief      read the latest frame
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *latest pointer to a bpc latest structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 latest is busy
+ *             - 5 latest is disabled
+ * @note       it can run in any number of other contexts, the decoder publishes into the other slot
+ *             and never waits for the readers, the read is lock free but not wait free, it retries
+ *             BPC_LATEST_READ_RETRY times when the decoder publishes during the copy and returns 4
+ *             when the decoder keeps lapping it, the caller can call it again later
+ */
+uint8_t bpc_read_latest(bpc_handle_t *handle, bpc_latest_t *latest);
+
+/**
+ * @brief      get the stats
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[out] *stats pointer to a bpc stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stats is busy
+ *             - 5 stats is disabled
+ * @note       it can run in another context or in the receive callback, the copy is retried while
+ *             a counter changes, it is busy only when every retry meets an update
+ */
+uint8_t bpc_get_stats(bpc_handle_t *handle, bpc_stats_t *stats);
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to a bpc handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 stats is disabled
+ * @note      call it in the decoding context, e.g. the receive callback, or when the edge irq is disabled
+ */
+uint8_t bpc_reset_stats(bpc_handle_t *handle);
+
 /**
  * @}
  */
@@ -0,0 +1,631 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bpc_capture.c
+ * @brief     driver bpc capture source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_capture.h"
+
+/**
+ * @brief capture definition
+ */
+#define BPC_CAPTURE_MAX_VARINT        10                  /**< max varint length of a 64 bits delta */
+#define BPC_CAPTURE_MAX_TICK_RATE     1000000000UL        /**< 1ns */
+
+#if ((BPC_CAPTURE_BLOCK_SIZE < 64) || (BPC_CAPTURE_BLOCK_SIZE > 65535))
+    #error "BPC_CAPTURE_BLOCK_SIZE must be from 64 to 65535"
+#endif
+
+/**
+ * @brief     capture put a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] value put value
+ * @param[in] len byte length
+ * @note      none
+ */
+static inline void a_bpc_capture_put(uint8_t *buf, uint64_t value, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)                              /* low byte first */
+    {
+        buf[i] = (uint8_t)(value >> (8 * i));              /* set the byte */
+    }
+}
+
+/**
+ * @brief     capture get a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len byte length
+ * @return    got value
+ * @note      none
+ */
+static inline uint64_t a_bpc_capture_get(const uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint64_t value;
+    
+    value = 0;                                             /* init 0 */
+    for (i = 0; i < len; i++)                              /* low byte first */
+    {
+        value |= (uint64_t)buf[i] << (8 * i);              /* get the byte */
+    }
+    
+    return value;                                          /* return the value */
+}
+
+/**
+ * @brief     capture convert a time to ticks
+ * @param[in] *t pointer to a time structure
+ * @param[in] tick_rate ticks per second
+ * @return    ticks
+ * @note      none
+ */
+static inline uint64_t a_bpc_capture_tick(const bpc_time_t *t, uint32_t tick_rate)
+{
+    return t->s * tick_rate + (uint64_t)t->us * tick_rate / 1000000;        /* convert to ticks */
+}
+
+/**
+ * @brief      capture convert ticks to a time
+ * @param[in]  tick ticks
+ * @param[in]  tick_rate ticks per second
+ * @param[out] *t pointer to a time structure
+ * @note       none
+ */
+static inline void a_bpc_capture_time(uint64_t tick, uint32_t tick_rate, bpc_time_t *t)
+{
+    t->s = tick / tick_rate;                                                       /* set s */
+    t->us = (uint32_t)((tick % tick_rate) * 1000000 / tick_rate);                  /* set us */
+}
+
+/**
+ * @brief     capture write the file header
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bpc_capture_write_header(bpc_capture_writer_t *writer)
+{
+    uint8_t buf[BPC_CAPTURE_HEADER_SIZE];
+    
+    memset(buf, 0, sizeof(uint8_t) * BPC_CAPTURE_HEADER_SIZE);                      /* clear the buffer */
+    memcpy(&buf[0], BPC_CAPTURE_MAGIC, 4);                                          /* set the magic */
+    a_bpc_capture_put(&buf[4], BPC_CAPTURE_VERSION, 2);                             /* set the version */
+    a_bpc_capture_put(&buf[6], BPC_CAPTURE_HEADER_SIZE, 2);                         /* set the header size */
+    a_bpc_capture_put(&buf[8], writer->header.tick_rate, 4);                        /* set the tick rate */
+    buf[12] = writer->header.source;                                                /* set the source */
+    buf[13] = writer->header.polarity;                                              /* set the polarity */
+    a_bpc_capture_put(&buf[14], writer->header.block_size, 2);                      /* set the block size */
+    a_bpc_capture_put(&buf[16], writer->header.block_count, 4);                     /* set the block count */
+    a_bpc_capture_put(&buf[24], writer->header.edge_count, 8);                      /* set the edge count */
+    a_bpc_capture_put(&buf[32], writer->header.first_tick, 8);                      /* set the first tick */
+    a_bpc_capture_put(&buf[40], writer->header.last_tick, 8);                       /* set the last tick */
+    
+    return writer->write(0, buf, BPC_CAPTURE_HEADER_SIZE);                          /* write the header */
+}
+
+/**
+ * @brief     capture write the current block
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the unused bytes are 0
+ */
+static uint8_t a_bpc_capture_write_block(bpc_capture_writer_t *writer)
+{
+    uint64_t offset;
+    
+    a_bpc_capture_put(&writer->block[16], writer->block_edge, 2);                                    /* set the edge count */
+    a_bpc_capture_put(&writer->block[18], writer->block_len, 2);                                     /* set the used length */
+    memset(&writer->block[writer->block_len], 0, BPC_CAPTURE_BLOCK_SIZE - writer->block_len);        /* clear the unused bytes */
+    offset = BPC_CAPTURE_HEADER_SIZE + (uint64_t)writer->header.block_count * BPC_CAPTURE_BLOCK_SIZE;  /* get the block offset */
+    if (writer->write(offset, writer->block, BPC_CAPTURE_BLOCK_SIZE) != 0)                           /* write the block */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    writer->header.block_count++;                                                                    /* block count++ */
+    writer->block_edge = 0;                                                                          /* init 0 */
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      capture get the block address
+ * @param[in]  *reader pointer to a bpc capture reader structure
+ * @param[in]  block block number
+ * @return     block address
+ * @note       none
+ */
+static inline const uint8_t *a_bpc_capture_block(bpc_capture_reader_t *reader, uint32_t block)
+{
+    return reader->buf + reader->offset + (size_t)block * reader->header.block_size;        /* get the block */
+}
+
+/**
+ * @brief     initialize the capture writer and write the file header
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @param[in] tick_rate ticks per second
+ * @param[in] source edge source
+ * @param[in] polarity 0: the pulse is low, 1: the pulse is high, 2: unknown
+ * @param[in] *write pointer to a write function address, it writes len bytes at the file offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 4 param is invalid
+ * @note      tick_rate is from 1 to 1000000000
+ */
+uint8_t bpc_capture_writer_init(bpc_capture_writer_t *writer, uint32_t tick_rate, bpc_capture_source_t source, 
+                                uint8_t polarity, uint8_t (*write)(uint64_t offset, const uint8_t *buf, uint32_t len))
+{
+    if (writer == NULL)                                                          /* check writer */
+    {
+        return 2;                                                                /* return error */
+    }
+    if ((write == NULL) || (tick_rate == 0) || 
+        (tick_rate > BPC_CAPTURE_MAX_TICK_RATE) || (polarity > 2))               /* check the param */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    memset(&writer->header, 0, sizeof(bpc_capture_header_t));                   /* clear the header */
+    writer->write = write;                                                       /* set the write function */
+    writer->header.tick_rate = tick_rate;                                        /* set the tick rate */
+    writer->header.source = (uint8_t)source;                                     /* set the source */
+    writer->header.polarity = polarity;                                          /* set the polarity */
+    writer->header.block_size = BPC_CAPTURE_BLOCK_SIZE;                          /* set the block size */
+    writer->block_len = 0;                                                       /* init 0 */
+    writer->block_edge = 0;                                                      /* init 0 */
+    if (a_bpc_capture_write_header(writer) != 0)                                 /* write the header */
+    {
+        return 1;                                                                /* return error */
+    }
+    writer->inited = 1;                                                          /* flag inited */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     write an edge
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not initialized
+ *            - 4 edge is earlier than the last edge
+ * @note      a full block is written at once
+ */
+uint8_t bpc_capture_write(bpc_capture_writer_t *writer, const bpc_time_t *t)
+{
+    uint64_t tick;
+    uint64_t delta;
+    
+    if (writer == NULL)                                                                              /* check writer */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (writer->inited != 1)                                                                         /* check writer initialization */
+    {
+        return 3;                                                                                    /* return error */
+    }
+    if (t == NULL)                                                                                   /* check t */
+    {
+        return 4;                                                                                    /* return error */
+    }
+    
+    tick = a_bpc_capture_tick(t, writer->header.tick_rate);                                         /* get the ticks */
+    if ((writer->header.edge_count != 0) && (tick < writer->header.last_tick))                      /* check the order */
+    {
+        return 4;                                                                                    /* return error */
+    }
+    if ((writer->block_edge != 0) && 
+        ((writer->block_len + BPC_CAPTURE_MAX_VARINT) > BPC_CAPTURE_BLOCK_SIZE))                    /* the block is full */
+    {
+        if (a_bpc_capture_write_block(writer) != 0)                                                  /* write the block */
+        {
+            return 1;                                                                                /* return error */
+        }
+    }
+    if (writer->block_edge == 0)                                                                     /* a new block */
+    {
+        memset(writer->block, 0, BPC_CAPTURE_BLOCK_HEADER_SIZE);                                     /* clear the block header */
+        a_bpc_capture_put(&writer->block[0], tick, 8);                                               /* set the first tick */
+        a_bpc_capture_put(&writer->block[8], writer->header.edge_count, 8);                         /* set the first edge number */
+        writer->block_len = BPC_CAPTURE_BLOCK_HEADER_SIZE;                                           /* set the used length */
+    }
+    else
+    {
+        delta = tick - writer->header.last_tick;                                                     /* get the delta */
+        while (delta >= 0x80)                                                                        /* 7 bits a byte */
+        {
+            writer->block[writer->block_len++] = (uint8_t)((delta & 0x7F) | 0x80);                  /* set the byte */
+            delta >>= 7;                                                                             /* next 7 bits */
+        }
+        writer->block[writer->block_len++] = (uint8_t)delta;                                         /* set the last byte */
+    }
+    if (writer->header.edge_count == 0)                                                              /* the first edge */
+    {
+        writer->header.first_tick = tick;                                                            /* set the first tick */
+    }
+    writer->header.last_tick = tick;                                                                 /* set the last tick */
+    writer->header.edge_count++;                                                                     /* edge count++ */
+    writer->block_edge++;                                                                            /* block edge++ */
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     close the capture writer
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not initialized
+ * @note      it writes the last block and updates the file header
+ */
+uint8_t bpc_capture_writer_close(bpc_capture_writer_t *writer)
+{
+    if (writer == NULL)                                                    /* check writer */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (writer->inited != 1)                                               /* check writer initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (writer->block_edge != 0)                                           /* the last block */
+    {
+        if (a_bpc_capture_write_block(writer) != 0)                        /* write the block */
+        {
+            return 1;                                                      /* return error */
+        }
+    }
+    if (a_bpc_capture_write_header(writer) != 0)                           /* update the header */
+    {
+        return 1;                                                          /* return error */
+    }
+    writer->inited = 0;                                                    /* flag closed */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the capture reader
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] *buf pointer to the file content
+ * @param[in] len file length
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ *            - 4 file is invalid
+ * @note      the reader never copies buf, it must be valid until the reader is no longer used,
+ *            a file without the final header, e.g. cut by a power loss, is read up to its last whole block
+ */
+uint8_t bpc_capture_reader_init(bpc_capture_reader_t *reader, const uint8_t *buf, size_t len)
+{
+    uint16_t header_size;
+    
+    if (reader == NULL)                                                                          /* check reader */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if ((buf == NULL) || (len < BPC_CAPTURE_HEADER_SIZE) || 
+        (memcmp(buf, BPC_CAPTURE_MAGIC, 4) != 0) || 
+        (a_bpc_capture_get(&buf[4], 2) != BPC_CAPTURE_VERSION))                                  /* check the magic and version */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    header_size = (uint16_t)a_bpc_capture_get(&buf[6], 2);                                       /* get the header size */
+    reader->header.tick_rate = (uint32_t)a_bpc_capture_get(&buf[8], 4);                          /* get the tick rate */
+    reader->header.source = buf[12];                                                             /* get the source */
+    reader->header.polarity = buf[13];                                                           /* get the polarity */
+    reader->header.block_size = (uint16_t)a_bpc_capture_get(&buf[14], 2);                        /* get the block size */
+    reader->header.block_count = (uint32_t)a_bpc_capture_get(&buf[16], 4);                       /* get the block count */
+    reader->header.edge_count = a_bpc_capture_get(&buf[24], 8);                                  /* get the edge count */
+    reader->header.first_tick = a_bpc_capture_get(&buf[32], 8);                                  /* get the first tick */
+    reader->header.last_tick = a_bpc_capture_get(&buf[40], 8);                                   /* get the last tick */
+    if ((header_size < BPC_CAPTURE_HEADER_SIZE) || (header_size > len) || 
+        (reader->header.tick_rate == 0) || (reader->header.tick_rate > BPC_CAPTURE_MAX_TICK_RATE) || 
+        (reader->header.block_size < (BPC_CAPTURE_BLOCK_HEADER_SIZE + BPC_CAPTURE_MAX_VARINT)))   /* check the header */
+    {
+        return 4;                                                                                /* return error */
+    }
+    if (reader->header.block_count == 0)                                                         /* not closed */
+    {
+        reader->header.block_count = (uint32_t)((len - header_size) / reader->header.block_size); /* use the whole blocks */
+    }
+    if ((uint64_t)reader->header.block_count * reader->header.block_size > len - header_size)    /* check the length */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    reader->buf = buf;                                                                           /* set the buffer */
+    reader->len = len;                                                                           /* set the length */
+    reader->offset = header_size;                                                                /* set the first block */
+    reader->block = 0;                                                                           /* init 0 */
+    reader->block_edge = 0;                                                                      /* init 0 */
+    reader->pos = 0;                                                                             /* init 0 */
+    reader->tick = 0;                                                                            /* init 0 */
+    reader->inited = 1;                                                                          /* flag inited */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      read the next edge
+ * @param[in]  *reader pointer to a bpc capture reader structure
+ * @param[out] *t pointer to an edge timestamp structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more edges
+ *             - 2 reader is NULL
+ *             - 3 reader is not initialized
+ *             - 4 block is invalid
+ * @note       none
+ */
+uint8_t bpc_capture_read(bpc_capture_reader_t *reader, bpc_time_t *t)
+{
+    uint8_t shift;
+    uint16_t used;
+    uint64_t delta;
+    const uint8_t *block;
+    
+    if (reader == NULL)                                                                          /* check reader */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (reader->inited != 1)                                                                     /* check reader initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    while (1)                                                                                    /* find the next edge */
+    {
+        if (reader->block >= reader->header.block_count)                                         /* no more blocks */
+        {
+            return 1;                                                                            /* return the end */
+        }
+        block = a_bpc_capture_block(reader, reader->block);                                      /* get the block */
+        if (reader->block_edge < (uint16_t)a_bpc_capture_get(&block[16], 2))                     /* an edge is left */
+        {
+            break;                                                                               /* break */
+        }
+        reader->block++;                                                                         /* next block */
+        reader->block_edge = 0;                                                                  /* init 0 */
+    }
+    
+    if (reader->block_edge == 0)                                                                 /* the first edge */
+    {
+        reader->tick = a_bpc_capture_get(&block[0], 8);                                          /* get the first tick */
+        reader->pos = BPC_CAPTURE_BLOCK_HEADER_SIZE;                                             /* set the position */
+    }
+    else
+    {
+        used = (uint16_t)a_bpc_capture_get(&block[18], 2);                                       /* get the used length */
+        if (used > reader->header.block_size)                                                    /* check the used length */
+        {
+            return 4;                                                                            /* return error */
+        }
+        delta = 0;                                                                               /* init 0 */
+        shift = 0;                                                                               /* init 0 */
+        do
+        {
+            if ((reader->pos >= used) || (shift > 63))                                           /* check the varint */
+            {
+                return 4;                                                                        /* return error */
+            }
+            delta |= (uint64_t)(block[reader->pos] & 0x7F) << shift;                             /* get 7 bits */
+            shift = (uint8_t)(shift + 7);                                                        /* next 7 bits */
+        } while ((block[reader->pos++] & 0x80) != 0);                                            /* check the next byte */
+        reader->tick += delta;                                                                   /* add the delta */
+    }
+    reader->block_edge++;                                                                        /* block edge++ */
+    a_bpc_capture_time(reader->tick, reader->header.tick_rate, t);                               /* convert to the time */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     seek to the first edge at or after a time
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] *t pointer to a timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 no edge at or after the time
+ *            - 2 reader is NULL
+ *            - 3 reader is not initialized
+ *            - 4 block is invalid
+ * @note      the blocks are searched by their first edge time
+ */
+uint8_t bpc_capture_seek(bpc_capture_reader_t *reader, const bpc_time_t *t)
+{
+    uint8_t res;
+    uint32_t low;
+    uint32_t high;
+    uint32_t mid;
+    uint64_t tick;
+    bpc_time_t edge;
+    bpc_capture_reader_t last;
+    
+    if (reader == NULL)                                                                          /* check reader */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (reader->inited != 1)                                                                     /* check reader initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (t == NULL)                                                                               /* check t */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    tick = a_bpc_capture_tick(t, reader->header.tick_rate);                                     /* get the ticks */
+    low = 0;                                                                                     /* init 0 */
+    high = reader->header.block_count;                                                           /* init the block count */
+    while (high - low > 1)                                                                       /* find the last block starting at or before */
+    {
+        mid = low + (high - low) / 2;                                                            /* get the middle */
+        if (a_bpc_capture_get(a_bpc_capture_block(reader, mid), 8) <= tick)                      /* check the first tick */
+        {
+            low = mid;                                                                           /* search the upper half */
+        }
+        else
+        {
+            high = mid;                                                                          /* search the lower half */
+        }
+    }
+    reader->block = low;                                                                         /* set the block */
+    reader->block_edge = 0;                                                                      /* init 0 */
+    while (1)                                                                                    /* find the edge */
+    {
+        memcpy(&last, reader, sizeof(bpc_capture_reader_t));                                     /* save the position */
+        res = bpc_capture_read(reader, &edge);                                                   /* read an edge */
+        if (res != 0)                                                                            /* check the result */
+        {
+            return res;                                                                          /* return the result */
+        }
+        if (reader->tick >= tick)                                                                /* found */
+        {
+            memcpy(reader, &last, sizeof(bpc_capture_reader_t));                                 /* read it again next time */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+    }
+}
+
+/**
+ * @brief     seek to the first edge of a block
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] block block number
+ * @return    status code
+ *            - 0 success
+ *            - 1 block is over the block count
+ *            - 2 reader is NULL
+ *            - 3 reader is not initialized
+ * @note      blocks split a capture into parts decoded independently
+ */
+uint8_t bpc_capture_seek_block(bpc_capture_reader_t *reader, uint32_t block)
+{
+    if (reader == NULL)                                                    /* check reader */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (reader->inited != 1)                                               /* check reader initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if (block >= reader->header.block_count)                               /* check the block */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    reader->block = block;                                                 /* set the block */
+    reader->block_edge = 0;                                                /* init 0 */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      replay edges into a decoder
+ * @param[in]  *reader pointer to a bpc capture reader structure
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[in]  max max replayed edge count
+ * @param[out] *count pointer to a replayed edge count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ *             - 2 reader is NULL
+ *             - 3 reader is not initialized
+ *             - 4 block is invalid
+ * @note       every edge runs bpc_irq_handler_at, it stops early at the end of the file
+ */
+uint8_t bpc_capture_replay(bpc_capture_reader_t *reader, bpc_handle_t *handle, size_t max, size_t *count)
+{
+    uint8_t res;
+    size_t n;
+    bpc_time_t t;
+    
+    if (reader == NULL)                                                    /* check reader */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (reader->inited != 1)                                               /* check reader initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    n = 0;                                                                 /* init 0 */
+    while (n < max)                                                        /* replay the edges */
+    {
+        res = bpc_capture_read(reader, &t);                                /* read an edge */
+        if (res == 1)                                                      /* the end */
+        {
+            break;                                                         /* break */
+        }
+        if (res != 0)                                                      /* check the result */
+        {
+            if (count != NULL)                                             /* count is needed */
+            {
+                *count = n;                                                /* set the count */
+            }
+            
+            return res;                                                    /* return error */
+        }
+        if (bpc_irq_handler_at(handle, &t) != 0)                           /* decode the edge */
+        {
+            if (count != NULL)                                             /* count is needed */
+            {
+                *count = n;                                                /* set the count */
+            }
+            
+            return 1;                                                      /* return error */
+        }
+        n++;                                                               /* n++ */
+    }
+    if (count != NULL)                                                     /* count is needed */
+    {
+        *count = n;                                                        /* set the count */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
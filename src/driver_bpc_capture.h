@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bpc_capture.h
+ * @brief     driver bpc capture header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BPC_CAPTURE_H
+#define DRIVER_BPC_CAPTURE_H
+
+#include "driver_bpc.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup bpc_capture_driver bpc capture driver function
+ * @brief    bpc capture driver modules
+ * @ingroup  bpc_driver
+ * @{
+ */
+
+/**
+ * @brief bpc capture format definition
+ * @note  all fields are little endian, the file is a header, then block_count blocks of block_size bytes,
+ *        every block starts with its first edge time and edge number, so the blocks are the seek index,
+ *        the other edges of a block are the tick deltas to the previous edge as LEB128 varints
+ */
+#define BPC_CAPTURE_MAGIC                "BPCC"        /**< file magic */
+#define BPC_CAPTURE_VERSION              1             /**< format version */
+#define BPC_CAPTURE_HEADER_SIZE          64            /**< file header size */
+#define BPC_CAPTURE_BLOCK_HEADER_SIZE    24            /**< block header size */
+
+/**
+ * @brief bpc capture block size definition
+ */
+#ifndef BPC_CAPTURE_BLOCK_SIZE
+    #define BPC_CAPTURE_BLOCK_SIZE        512        /**< written block size from 64 to 65535 */
+#endif
+
+/**
+ * @brief bpc capture source enumeration definition
+ */
+typedef enum
+{
+    BPC_CAPTURE_SOURCE_UNKNOWN   = 0x00,        /**< unknown */
+    BPC_CAPTURE_SOURCE_GPIO      = 0x01,        /**< gpio interrupt */
+    BPC_CAPTURE_SOURCE_TIMER     = 0x02,        /**< timer input capture */
+    BPC_CAPTURE_SOURCE_SYNTHETIC = 0x03,        /**< bpc encoder */
+} bpc_capture_source_t;
+
+/**
+ * @brief bpc capture header structure definition
+ */
+typedef struct bpc_capture_header_s
+{
+    uint32_t tick_rate;          /**< ticks per second */
+    uint8_t source;              /**< edge source */
+    uint8_t polarity;            /**< 0: the pulse is low, 1: the pulse is high, 2: unknown */
+    uint16_t block_size;         /**< block size in bytes */
+    uint32_t block_count;        /**< block count */
+    uint64_t edge_count;         /**< edge count */
+    uint64_t first_tick;         /**< first edge time in ticks */
+    uint64_t last_tick;          /**< last edge time in ticks */
+} bpc_capture_header_t;
+
+/**
+ * @brief bpc capture writer structure definition
+ */
+typedef struct bpc_capture_writer_s
+{
+    uint8_t (*write)(uint64_t offset, const uint8_t *buf, uint32_t len);        /**< point to a write function address */
+    bpc_capture_header_t header;                                                /**< file header */
+    uint8_t block[BPC_CAPTURE_BLOCK_SIZE];                                      /**< current block */
+    uint16_t block_len;                                                         /**< used bytes of the current block */
+    uint16_t block_edge;                                                        /**< edges of the current block */
+    uint8_t inited;                                                             /**< inited flag */
+} bpc_capture_writer_t;
+
+/**
+ * @brief bpc capture reader structure definition
+ */
+typedef struct bpc_capture_reader_s
+{
+    const uint8_t *buf;                 /**< file content, e.g. a mmap address */
+    size_t len;                         /**< file length */
+    bpc_capture_header_t header;        /**< file header */
+    size_t offset;                      /**< first block offset */
+    uint32_t block;                     /**< current block */
+    uint16_t block_edge;                /**< read edges of the current block */
+    uint16_t pos;                       /**< read position in the current block */
+    uint64_t tick;                      /**< last read edge time in ticks */
+    uint8_t inited;                     /**< inited flag */
+} bpc_capture_reader_t;
+
+/**
+ * @brief     initialize the capture writer and write the file header
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @param[in] tick_rate ticks per second
+ * @param[in] source edge source
+ * @param[in] polarity 0: the pulse is low, 1: the pulse is high, 2: unknown
+ * @param[in] *write pointer to a write function address, it writes len bytes at the file offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 4 param is invalid
+ * @note      tick_rate is from 1 to 1000000000
+ */
+uint8_t bpc_capture_writer_init(bpc_capture_writer_t *writer, uint32_t tick_rate, bpc_capture_source_t source, 
+                                uint8_t polarity, uint8_t (*write)(uint64_t offset, const uint8_t *buf, uint32_t len));
+
+/**
+ * @brief     write an edge
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not initialized
+ *            - 4 edge is earlier than the last edge
+ * @note      a full block is written at once
+ */
+uint8_t bpc_capture_write(bpc_capture_writer_t *writer, const bpc_time_t *t);
+
+/**
+ * @brief     close the capture writer
+ * @param[in] *writer pointer to a bpc capture writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not initialized
+ * @note      it writes the last block and updates the file header
+ */
+uint8_t bpc_capture_writer_close(bpc_capture_writer_t *writer);
+
+/**
+ * @brief     initialize the capture reader
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] *buf pointer to the file content
+ * @param[in] len file length
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ *            - 4 file is invalid
+ * @note      the reader never copies buf, it must be valid until the reader is no longer used
+ */
+uint8_t bpc_capture_reader_init(bpc_capture_reader_t *reader, const uint8_t *buf, size_t len);
+
+/**
+ * @brief      read the next edge
+ * @param[in]  *reader pointer to a bpc capture reader structure
+ * @param[out] *t pointer to an edge timestamp structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more edges
+ *             - 2 reader is NULL
+ *             - 3 reader is not initialized
+ *             - 4 block is invalid
+ * @note       none
+ */
+uint8_t bpc_capture_read(bpc_capture_reader_t *reader, bpc_time_t *t);
+
+/**
+ * @brief     seek to the first edge at or after a time
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] *t pointer to a timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 no edge at or after the time
+ *            - 2 reader is NULL
+ *            - 3 reader is not initialized
+ *            - 4 block is invalid
+ * @note      the blocks are searched by their first edge time
+ */
+uint8_t bpc_capture_seek(bpc_capture_reader_t *reader, const bpc_time_t *t);
+
+/**
+ * @brief     seek to the first edge of a block
+ * @param[in] *reader pointer to a bpc capture reader structure
+ * @param[in] block block number
+ * @return    status code
+ *            - 0 success
+ *            - 1 block is over the block count
+ *            - 2 reader is NULL
+ *            - 3 reader is not initialized
+ * @note      blocks split a capture into parts decoded independently
+ */
+uint8_t bpc_capture_seek_block(bpc_capture_reader_t *reader, uint32_t block);
+
+/**
+ * @brief      replay edges into a decoder
+ * @param[in]  *reader pointer to a bpc capture reader structure
+ * @param[in]  *handle pointer to a bpc handle structure
+ * @param[in]  max max replayed edge count
+ * @param[out] *count pointer to a replayed edge count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ *             - 2 reader is NULL
+ *             - 3 reader is not initialized
+ *             - 4 block is invalid
+ * @note       every edge runs bpc_irq_handler_at, it stops early at the end of the file
+ */
+uint8_t bpc_capture_replay(bpc_capture_reader_t *reader, bpc_handle_t *handle, size_t max, size_t *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,339 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bpc_encoder.c
+ * @brief     driver bpc encoder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bpc_encoder.h"
+
+/**
+ * @brief encoder time definition
+ */
+#define BPC_ENCODER_FRAME_US             (20ULL * 1000 * 1000)   /**< frame time */
+#define BPC_ENCODER_SECOND_US            (1000ULL * 1000)        /**< symbol time */
+#define BPC_ENCODER_DATA_US              (100ULL * 1000)         /**< data 0 pulse time */
+#define BPC_ENCODER_MAX_JITTER_US        (50 * 1000)             /**< max jitter, half of the shortest pulse */
+
+/**
+ * @brief     encoder random
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @return    random value
+ * @note      xorshift32
+ */
+static uint32_t a_bpc_encoder_rand(bpc_encoder_t *encoder)
+{
+    uint32_t x;
+    
+    x = encoder->rng;                   /* get the state */
+    x ^= x << 13;                       /* shift */
+    x ^= x >> 17;                       /* shift */
+    x ^= x << 5;                        /* shift */
+    encoder->rng = x;                   /* save the state */
+    
+    return x;                           /* return the random */
+}
+
+/**
+ * @brief     encoder chance
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @param[in] permille probability in 1/1000
+ * @return    1 if it happens, otherwise 0
+ * @note      none
+ */
+static uint8_t a_bpc_encoder_chance(bpc_encoder_t *encoder, uint16_t permille)
+{
+    if (permille == 0)                                                          /* never */
+    {
+        return 0;                                                               /* return 0 */
+    }
+    
+    return (uint8_t)((a_bpc_encoder_rand(encoder) % 1000) < permille);          /* check the random */
+}
+
+/**
+ * @brief      encoder time
+ * @param[in]  *encoder pointer to a bpc encoder structure
+ * @param[in]  nominal_us nominal time from the start in us
+ * @param[in]  jitter 1 to add the jitter
+ * @param[out] *t pointer to a time structure
+ * @note       the skew scales the time from the start
+ */
+static void a_bpc_encoder_time(bpc_encoder_t *encoder, uint64_t nominal_us, uint8_t jitter, bpc_time_t *t)
+{
+    int64_t us;
+    uint64_t total;
+    
+    us = (int64_t)nominal_us + (int64_t)nominal_us * encoder->config.skew_ppm / 1000000;        /* add the skew */
+    if ((jitter != 0) && (encoder->config.jitter_us != 0))                                       /* add the jitter */
+    {
+        us += (int64_t)(a_bpc_encoder_rand(encoder) % (2 * encoder->config.jitter_us + 1)) - 
+              (int64_t)encoder->config.jitter_us;                                                /* uniform jitter */
+    }
+    if (us < 0)                                                                                  /* before the start */
+    {
+        us = 0;                                                                                  /* set the start */
+    }
+    total = (uint64_t)encoder->start.us + (uint64_t)us;                                          /* add the start */
+    t->s = encoder->start.s + total / 1000000;                                                   /* set s */
+    t->us = (uint32_t)(total % 1000000);                                                         /* set us */
+}
+
+/**
+ * @brief      encoder symbol
+ * @param[in]  *data pointer to a bpc structure
+ * @param[out] *s pointer to a frame symbol buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is invalid
+ * @note       p3 and p4 carry the pm and year high bits and the parity of their half
+ */
+static uint8_t a_bpc_encoder_symbol(const bpc_t *data, uint8_t *s)
+{
+    uint8_t i;
+    uint8_t hour;
+    uint8_t year;
+    uint8_t parity;
+    
+    if (((data->second != 19) && (data->second != 39) && (data->second != 59)) || 
+        (data->year < 2000) || (data->year > 2127) || 
+        (data->month < 1) || (data->month > 12) || 
+        (data->day < 1) || (data->day > 31) || 
+        (data->week > 7) || (data->hour > 23) || (data->minute > 59))                  /* check the data */
+    {
+        return 1;                                                                      /* return error */
+    }
+    
+    hour = (uint8_t)(data->hour % 12);                                                 /* 12h hour */
+    year = (uint8_t)(data->year - 2000);                                               /* year from 2000 */
+    s[0] = (uint8_t)((data->second - 19) / 20);                                        /* set p1 */
+    s[1] = 0;                                                                          /* set p2 */
+    s[2] = (uint8_t)((hour >> 2) & 0x3);                                               /* set hour */
+    s[3] = (uint8_t)(hour & 0x3);                                                      /* set hour */
+    s[4] = (uint8_t)((data->minute >> 4) & 0x3);                                       /* set minute */
+    s[5] = (uint8_t)((data->minute >> 2) & 0x3);                                       /* set minute */
+    s[6] = (uint8_t)(data->minute & 0x3);                                              /* set minute */
+    s[7] = (uint8_t)((data->week >> 2) & 0x3);                                         /* set week */
+    s[8] = (uint8_t)(data->week & 0x3);                                                /* set week */
+    s[10] = (uint8_t)((data->day >> 4) & 0x3);                                         /* set day */
+    s[11] = (uint8_t)((data->day >> 2) & 0x3);                                         /* set day */
+    s[12] = (uint8_t)(data->day & 0x3);                                                /* set day */
+    s[13] = (uint8_t)((data->month >> 2) & 0x3);                                       /* set month */
+    s[14] = (uint8_t)(data->month & 0x3);                                              /* set month */
+    s[15] = (uint8_t)((year >> 4) & 0x3);                                              /* set year */
+    s[16] = (uint8_t)((year >> 2) & 0x3);                                              /* set year */
+    s[17] = (uint8_t)(year & 0x3);                                                     /* set year */
+    parity = 0;                                                                        /* init 0 */
+    for (i = 0; i < 9; i++)                                                            /* p1, p2, hour, minute and week */
+    {
+        parity ^= (uint8_t)((s[i] ^ (s[i] >> 1)) & 0x1);                               /* update the parity */
+    }
+    s[9] = (uint8_t)(((data->hour >= 12) ? 2 : 0) | parity);                           /* set p3 */
+    parity = 0;                                                                        /* init 0 */
+    for (i = 10; i < 18; i++)                                                          /* day, month and year */
+    {
+        parity ^= (uint8_t)((s[i] ^ (s[i] >> 1)) & 0x1);                               /* update the parity */
+    }
+    s[18] = (uint8_t)((((year >> 6) & 0x1) << 1) | parity);                            /* set p4 */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     initialize the encoder
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @param[in] *config pointer to a bpc encoder config structure
+ * @param[in] *start pointer to the start time of the first frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 encoder is NULL
+ *            - 4 config is invalid
+ * @note      the first frame starts with its missing second at start
+ */
+uint8_t bpc_encoder_init(bpc_encoder_t *encoder, const bpc_encoder_config_t *config, const bpc_time_t *start)
+{
+    if (encoder == NULL)                                                   /* check encoder */
+    {
+        return 2;                                                          /* return error */
+    }
+    if ((config == NULL) || (start == NULL) || 
+        (config->jitter_us >= BPC_ENCODER_MAX_JITTER_US) || 
+        (config->drop_permille > 1000) || (config->spurious_permille > 1000) || 
+        (config->polarity > 1) || (start->us >= 1000000))                  /* check the config */
+    {
+        return 4;                                                          /* return error */
+    }
+    
+    memcpy(&encoder->config, config, sizeof(bpc_encoder_config_t));        /* copy the config */
+    encoder->start.s = start->s;                                           /* set the start */
+    encoder->start.us = start->us;                                         /* set the start */
+    encoder->frame_us = 0;                                                 /* init 0 */
+    encoder->rng = (config->seed != 0) ? config->seed : 1;                 /* set the random seed */
+    encoder->inited = 1;                                                   /* flag inited */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief         encode one frame
+ * @param[in]     *encoder pointer to a bpc encoder structure
+ * @param[in]     *data pointer to a bpc structure
+ * @param[out]    *edges pointer to an edge timestamp buffer
+ * @param[out]    *level pointer to an edge level buffer, it can be NULL
+ * @param[in,out] *len pointer to a buffer length, BPC_ENCODER_MAX_EDGE is always enough
+ * @return        status code
+ *                - 0 success
+ *                - 1 buffer is too small
+ *                - 2 encoder is NULL
+ *                - 3 encoder is not initialized
+ *                - 4 data is invalid
+ * @note          one frame takes 20s, second must be 19, 39 or 59 and the level is the pin level after the edge
+ */
+uint8_t bpc_encode(bpc_encoder_t *encoder, const bpc_t *data, bpc_time_t *edges, uint8_t *level, uint16_t *len)
+{
+    uint8_t i;
+    uint8_t pulse;
+    uint8_t lvl;
+    uint8_t s[BPC_FRAME_SYMBOL_LEN];
+    uint16_t n;
+    uint32_t width;
+    uint64_t t;
+    uint64_t next;
+    uint64_t glitch;
+    
+    if (encoder == NULL)                                                                     /* check encoder */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (encoder->inited != 1)                                                                /* check encoder initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    if ((data == NULL) || (edges == NULL) || (len == NULL))                                  /* check the buffer */
+    {
+        return 4;                                                                            /* return error */
+    }
+    if (a_bpc_encoder_symbol(data, s) != 0)                                                  /* get the symbols */
+    {
+        return 4;                                                                            /* return error */
+    }
+    
+    pulse = encoder->config.polarity;                                                        /* pulse level */
+    n = 0;                                                                                   /* init 0 */
+    for (i = 0; i < BPC_FRAME_SYMBOL_LEN * 2; i++)                                           /* rising and falling edges */
+    {
+        t = encoder->frame_us + (uint64_t)(i / 2 + 1) * BPC_ENCODER_SECOND_US;               /* symbol start */
+        if ((i & 0x1) != 0)                                                                  /* pulse end */
+        {
+            t += (uint64_t)(s[i / 2] + 1) * BPC_ENCODER_DATA_US;                             /* add the pulse time */
+            next = encoder->frame_us + (uint64_t)(i / 2 + 2) * BPC_ENCODER_SECOND_US;        /* next symbol start */
+            lvl = (uint8_t)(pulse ^ 0x1);                                                    /* idle level */
+        }
+        else
+        {
+            next = t + (uint64_t)(s[i / 2] + 1) * BPC_ENCODER_DATA_US;                       /* pulse end */
+            lvl = pulse;                                                                     /* pulse level */
+        }
+        if (i == (BPC_FRAME_SYMBOL_LEN * 2 - 1))                                             /* the last edge */
+        {
+            next += BPC_ENCODER_SECOND_US;                                                   /* the missing second */
+        }
+        if (a_bpc_encoder_chance(encoder, encoder->config.drop_permille) == 0)               /* not dropped */
+        {
+            if (n >= *len)                                                                   /* check the length */
+            {
+                return 1;                                                                    /* return error */
+            }
+            a_bpc_encoder_time(encoder, t, 1, &edges[n]);                                    /* set the edge */
+            if (level != NULL)                                                               /* level is needed */
+            {
+                level[n] = lvl;                                                              /* set the level */
+            }
+            n++;                                                                             /* n++ */
+        }
+        if (a_bpc_encoder_chance(encoder, encoder->config.spurious_permille) != 0)           /* add a spurious pulse */
+        {
+            glitch = t + encoder->config.jitter_us + 1 + 
+                     a_bpc_encoder_rand(encoder) % ((next - t) / 2);                         /* glitch start after the jittered edge */
+            width = 1;                                                                       /* init 1 */
+            if (encoder->config.spurious_max_us != 0)                                        /* random width */
+            {
+                width += a_bpc_encoder_rand(encoder) % encoder->config.spurious_max_us;      /* set the width */
+            }
+            if (glitch + width + encoder->config.jitter_us < next)                           /* before the next jittered edge */
+            {
+                if ((n + 2) > *len)                                                          /* check the length */
+                {
+                    return 1;                                                                /* return error */
+                }
+                a_bpc_encoder_time(encoder, glitch, 0, &edges[n]);                           /* set the glitch start */
+                a_bpc_encoder_time(encoder, glitch + width, 0, &edges[n + 1]);               /* set the glitch end */
+                if (level != NULL)                                                           /* level is needed */
+                {
+                    level[n] = (uint8_t)(lvl ^ 0x1);                                         /* toggle */
+                    level[n + 1] = lvl;                                                      /* back */
+                }
+                n = (uint16_t)(n + 2);                                                       /* n += 2 */
+            }
+        }
+    }
+    encoder->frame_us += BPC_ENCODER_FRAME_US;                                               /* next frame */
+    *len = n;                                                                                /* set the length */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     skip frames without edges
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @param[in] frame skipped frame count
+ * @return    status code
+ *            - 0 success
+ *            - 2 encoder is NULL
+ *            - 3 encoder is not initialized
+ * @note      it simulates a lost signal
+ */
+uint8_t bpc_encode_skip(bpc_encoder_t *encoder, uint32_t frame)
+{
+    if (encoder == NULL)                                                   /* check encoder */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (encoder->inited != 1)                                              /* check encoder initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    encoder->frame_us += (uint64_t)frame * BPC_ENCODER_FRAME_US;           /* skip the frames */
+    
+    return 0;                                                              /* success return 0 */
+}
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bpc_encoder.h
+ * @brief     driver bpc encoder header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-16
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/16  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BPC_ENCODER_H
+#define DRIVER_BPC_ENCODER_H
+
+#include "driver_bpc.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup bpc_encoder_driver bpc encoder driver function
+ * @brief    bpc encoder driver modules
+ * @ingroup  bpc_driver
+ * @{
+ */
+
+/**
+ * @brief bpc encoder max edge definition
+ */
+#define BPC_ENCODER_MAX_EDGE        (BPC_FRAME_SYMBOL_LEN * 2 * 3)        /**< every edge may carry a spurious pulse */
+
+/**
+ * @brief bpc encoder config structure definition
+ */
+typedef struct bpc_encoder_config_s
+{
+    uint32_t jitter_us;              /**< max edge jitter in us, less than 50000 */
+    int32_t skew_ppm;                /**< transmitter clock skew in ppm */
+    uint16_t drop_permille;          /**< dropped edge probability in 1/1000 */
+    uint16_t spurious_permille;      /**< spurious pulse probability after each edge in 1/1000 */
+    uint32_t spurious_max_us;        /**< max spurious pulse width in us */
+    uint8_t polarity;                /**< 0: the pulse is low, 1: the pulse is high */
+    uint32_t seed;                   /**< random seed, 0 is replaced by 1 */
+} bpc_encoder_config_t;
+
+/**
+ * @brief bpc encoder structure definition
+ */
+typedef struct bpc_encoder_s
+{
+    bpc_encoder_config_t config;        /**< config */
+    bpc_time_t start;                   /**< encoder start time */
+    uint64_t frame_us;                  /**< nominal start time of the next frame in us */
+    uint32_t rng;                       /**< random state */
+    uint8_t inited;                     /**< inited flag */
+} bpc_encoder_t;
+
+/**
+ * @brief     initialize the encoder
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @param[in] *config pointer to a bpc encoder config structure
+ * @param[in] *start pointer to the start time of the first frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 encoder is NULL
+ *            - 4 config is invalid
+ * @note      the first frame starts with its missing second at start
+ */
+uint8_t bpc_encoder_init(bpc_encoder_t *encoder, const bpc_encoder_config_t *config, const bpc_time_t *start);
+
+/**
+ * @brief         encode one frame
+ * @param[in]     *encoder pointer to a bpc encoder structure
+ * @param[in]     *data pointer to a bpc structure
+ * @param[out]    *edges pointer to an edge timestamp buffer
+ * @param[out]    *level pointer to an edge level buffer, it can be NULL
+ * @param[in,out] *len pointer to a buffer length, BPC_ENCODER_MAX_EDGE is always enough
+ * @return        status code
+ *                - 0 success
+ *                - 1 buffer is too small
+ *                - 2 encoder is NULL
+ *                - 3 encoder is not initialized
+ *                - 4 data is invalid
+ * @note          one frame takes 20s, second must be 19, 39 or 59 and the level is the pin level after the edge
+ */
+uint8_t bpc_encode(bpc_encoder_t *encoder, const bpc_t *data, bpc_time_t *edges, uint8_t *level, uint16_t *len);
+
+/**
+ * @brief     skip frames without edges
+ * @param[in] *encoder pointer to a bpc encoder structure
+ * @param[in] frame skipped frame count
+ * @return    status code
+ *            - 0 success
+ *            - 2 encoder is NULL
+ *            - 3 encoder is not initialized
+ * @note      it simulates a lost signal
+ */
+uint8_t bpc_encode_skip(bpc_encoder_t *encoder, uint32_t frame);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -56,6 +56,63 @@ uint8_t bpc_receive_test_irq_handler(void)
     return 0;
 }
 
+/**
+ * @brief     receive test irq with an edge timestamp
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t is the time when the edge occurred, e.g. a kernel event time
+ */
+uint8_t bpc_receive_test_irq_handler_at(const bpc_time_t *t)
+{
+    if (bpc_irq_handler_at(&gs_handle, t) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     receive test irq with an edge timestamp batch
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t must be in time order, e.g. the kernel events read at once
+ */
+uint8_t bpc_receive_test_irq_handler_batch(const bpc_time_t *t, size_t n)
+{
+    if (bpc_feed_edges(&gs_handle, t, n) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     receive test irq with a pulse and period pair
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the pair is captured by a timer in the pwm input mode
+ */
+uint8_t bpc_receive_test_irq_handler_pulse(const bpc_time_t *t, uint32_t width_us, uint32_t period_us)
+{
+    if (bpc_feed_pulse(&gs_handle, t, width_us, period_us) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] *data pointer to a bpc_t structure
@@ -59,6 +59,39 @@ extern "C"{
  */
 uint8_t bpc_receive_test_irq_handler(void);
 
+/**
+ * @brief     receive test irq with an edge timestamp
+ * @param[in] *t pointer to an edge timestamp structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t is the time when the edge occurred, e.g. a kernel event time
+ */
+uint8_t bpc_receive_test_irq_handler_at(const bpc_time_t *t);
+
+/**
+ * @brief     receive test irq with an edge timestamp batch
+ * @param[in] *t pointer to an edge timestamp buffer
+ * @param[in] n edge timestamp buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      t must be in time order, e.g. the kernel events read at once
+ */
+uint8_t bpc_receive_test_irq_handler_batch(const bpc_time_t *t, size_t n);
+
+/**
+ * @brief     receive test irq with a pulse and period pair
+ * @param[in] *t pointer to the timestamp of the edge closing the period
+ * @param[in] width_us pulse width in us
+ * @param[in] period_us period in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the pair is captured by a timer in the pwm input mode
+ */
+uint8_t bpc_receive_test_irq_handler_pulse(const bpc_time_t *t, uint32_t width_us, uint32_t period_us);
+
 /**
  * @brief     receive test
  * @param[in] times test times